@@ -5,7 +5,7 @@ outputFile="kriolu.exe"
 trace="//DDEBUG_TRACE_EXECUTION"
 
 if [[ $1 == "--release" ]]; then
-  trace=""
+  trace="//DKRIOLU_RELEASE"
 fi
 
 rm -rf build
@@ -0,0 +1,13 @@
+#!/usr/bin/sh
+
+basedir="$PWD"
+compiler="${CC:-cc}"
+
+rm -rf $basedir/tests/hash_table/build
+mkdir $basedir/tests/hash_table/build
+cd $basedir/tests/hash_table/build
+$compiler -O2 -std=gnu11 -I $basedir/src -o hash_table_benchmark $basedir/tests/hash_table/benchmark.c $basedir/tests/hash_table/object_string.c $basedir/src/hash_table.c $basedir/src/string.c $basedir/src/value.c
+cd -
+
+# Run the program
+# ./tests/hash_table/build/hash_table_benchmark [max_size]
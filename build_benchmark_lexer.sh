@@ -0,0 +1,13 @@
+#!/usr/bin/sh
+
+basedir="$PWD"
+compiler="${CC:-cc}"
+
+rm -rf $basedir/tests/lexer/build
+mkdir $basedir/tests/lexer/build
+cd $basedir/tests/lexer/build
+$compiler -O2 -std=gnu11 -I $basedir/src -o lexer_benchmark $basedir/tests/lexer/benchmark.c $basedir/src/lexer.c
+cd -
+
+# Run the program
+# ./tests/lexer/build/lexer_benchmark [megabytes]
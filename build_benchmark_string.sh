@@ -0,0 +1,13 @@
+#!/usr/bin/sh
+
+basedir="$PWD"
+compiler="${CC:-cc}"
+
+rm -rf $basedir/tests/string/build
+mkdir $basedir/tests/string/build
+cd $basedir/tests/string/build
+$compiler -O2 -std=gnu11 -I $basedir/src -o string_benchmark $basedir/tests/string/benchmark.c $basedir/src/string.c
+cd -
+
+# Run the program
+# ./tests/string/build/string_benchmark
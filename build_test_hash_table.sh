@@ -7,7 +7,7 @@ flags="//Zi //TC"
 rm -rf $basedir/tests/hash_table/build
 mkdir $basedir/tests/hash_table/build
 cd $basedir/tests/hash_table/build
-cl //Zi //TC //Fe:hash_test.exe //I $basedir/src $basedir/tests/hash_table/main.c $basedir/src/hash_table.c $basedir/src/string.c $basedir/src/object.c $basedir/tests/hash_table/object_string.c $basedir/src/value.c
+cl //Zi //TC //Fe:hash_test.exe //I $basedir/src $basedir/tests/hash_table/main.c $basedir/src/hash_table.c $basedir/src/string.c $basedir/tests/hash_table/object_string.c $basedir/src/value.c
 cd -
 
 # Run the program
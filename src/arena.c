@@ -0,0 +1,84 @@
+#include "kriolu.h"
+
+// Arena
+//
+// Allocations bump 'used' inside the current block; when it doesn't fit a
+// new block is chained in front of it, big enough for the allocation. The
+// blocks come from 'calloc' and nothing is handed out twice, so the memory
+// is always zeroed. Nothing is freed on its own, 'Arena_free' releases all
+// the blocks at once.
+//
+
+static ArenaBlock* Arena_push_block(Arena* arena, size_t size) {
+    size_t capacity = ARENA_BLOCK_SIZE;
+    if (capacity < size) capacity = size;
+
+    ArenaBlock* block = (ArenaBlock*)calloc(1, sizeof(ArenaBlock) + capacity);
+    assert(block && "Error: Arena out of memory.");
+    block->capacity = capacity;
+    block->used     = 0;
+
+    LinkedList_push(arena->blocks, block);
+    arena->bytes_reserved += capacity;
+
+    return block;
+}
+
+static size_t Arena_align(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+}
+
+void Arena_init(Arena* arena) {
+    arena->blocks         = NULL;
+    arena->bytes_used     = 0;
+    arena->bytes_reserved = 0;
+}
+
+void* Arena_allocate(Arena* arena, size_t size) {
+    size = Arena_align(size);
+
+    ArenaBlock* block = arena->blocks;
+    if (block == NULL || block->capacity - block->used < size)
+        block = Arena_push_block(arena, size);
+
+    void* result = block->data + block->used;
+    block->used       += size;
+    arena->bytes_used += size;
+
+    return result;
+}
+
+// NOTE: Grows in place when 'pointer' is the last allocation and the block
+//       has room for it, otherwise copies into a new allocation (the old
+//       one stays in the arena until 'Arena_free').
+//
+void* Arena_reallocate(Arena* arena, void* pointer, size_t old_size, size_t new_size) {
+    if (pointer == NULL) return Arena_allocate(arena, new_size);
+
+    old_size = Arena_align(old_size);
+    new_size = Arena_align(new_size);
+    if (new_size <= old_size) return pointer;
+
+    ArenaBlock* block = arena->blocks;
+    bool is_last = (char*)pointer + old_size == block->data + block->used;
+    if (is_last && block->capacity - block->used >= new_size - old_size) {
+        block->used       += new_size - old_size;
+        arena->bytes_used += new_size - old_size;
+        return pointer;
+    }
+
+    void* result = Arena_allocate(arena, new_size);
+    memcpy(result, pointer, old_size);
+
+    return result;
+}
+
+void Arena_free(Arena* arena) {
+    while (arena->blocks != NULL) {
+        ArenaBlock* block = arena->blocks;
+        arena->blocks = block->next;
+        free(block);
+    }
+
+    Arena_init(arena);
+}
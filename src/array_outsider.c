@@ -1,21 +1,36 @@
 #include "kriolu.h"
 
-static int ArrayOutsider_find_index(ArrayOutsider* local_metadata, uint8_t index, LocalLocation location);
+static int ArrayOutsider_find_index(ArrayOutsider* local_metadata, int index, LocalLocation location);
 
-void ArrayOutsider_init(ArrayOutsider* local_metadata, int count) {
+// NOTE: 'items' is left as is, like 'StackLocal_init'.
+//
+void ArrayOutsider_init(ArrayOutsider* local_metadata, int count, Arena* arena) {
     local_metadata->count = count;
+    local_metadata->arena = arena;
 }
 
-int ArrayOutsider_add(ArrayOutsider* local_metadata, uint8_t index, LocalLocation location, int* variable_dependencies_count) {
-    assert(local_metadata->count < UINT8_COUNT && "You've reached the limit of runtime objects.");
+int ArrayOutsider_add(ArrayOutsider* local_metadata, int index, LocalLocation location, int* variable_dependencies_count) {
+    assert(local_metadata->count < OUTSIDERS_MAX && "You've reached the limit of runtime objects.");
+    assert(index < LOCALS_MAX);
 
     int local_metadata_index = ArrayOutsider_find_index(local_metadata, index, location);
     if (local_metadata_index != -1) return local_metadata_index;
 
-    if (local_metadata->count == UINT8_COUNT) return 0; 
+    if (local_metadata->count == OUTSIDERS_MAX) return 0; 
+
+    if (local_metadata->count == local_metadata->capacity) {
+        int capacity = local_metadata->capacity < 8 ? 8 : local_metadata->capacity * 2;
+        local_metadata->items = (Outsider*)Arena_reallocate(
+            local_metadata->arena,
+            local_metadata->items,
+            sizeof(Outsider) * local_metadata->capacity,
+            sizeof(Outsider) * capacity
+        );
+        local_metadata->capacity = capacity;
+    }
 
     Outsider* new_local_metadata = &local_metadata->items[local_metadata->count];
-    new_local_metadata->index = index;
+    new_local_metadata->index = (uint16_t)index;
     new_local_metadata->location = location;
     local_metadata->count += 1;
 
@@ -27,7 +42,7 @@ int ArrayOutsider_add(ArrayOutsider* local_metadata, uint8_t index, LocalLocatio
     return local_metadata->count - 1;
 }
 
-static int ArrayOutsider_find_index(ArrayOutsider* local_metadata, uint8_t index, LocalLocation location) {
+static int ArrayOutsider_find_index(ArrayOutsider* local_metadata, int index, LocalLocation location) {
     for (int i = 0; i < local_metadata->count; i++) {
         if (local_metadata->items[i].index == index && local_metadata->items[i].location == location)
             return i;
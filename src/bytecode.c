@@ -16,6 +16,98 @@ void Bytecode_init(Bytecode* bytecode) {
     bytecode->source_code.items    = NULL;
     bytecode->source_code.count    = 0;
     bytecode->source_code.capacity = 0;
+
+    bytecode->constants.slots    = NULL;
+    bytecode->constants.count    = 0;
+    bytecode->constants.capacity = 0;
+}
+
+static uint32_t Bytecode_hash_constant(Value value) {
+    uint64_t bits = 0;
+    if (value_is_number(value)) memcpy(&bits, &value.as.number, sizeof(bits));
+    else                        bits = (uint64_t)(uintptr_t)value_as_object(value);
+
+    bits ^= bits >> 33;
+    bits *= 0xff51afd7ed558ccdULL;
+    bits ^= bits >> 33;
+
+    return (uint32_t)bits;
+}
+
+// NOTE: Compares the bits, so '0' and '-0' stay two different constants.
+//
+static bool Bytecode_is_same_constant(Value a, Value b) {
+    if (a.kind != b.kind)   return false;
+    if (value_is_number(a)) return memcmp(&a.as.number, &b.as.number, sizeof(double)) == 0;
+
+    return value_as_object(a) == value_as_object(b);
+}
+
+// Rehashes 'values' into a table with room for them. Slots pointing past
+// 'values.count' (left behind by 'Bytecode_truncate') are dropped here, and
+// skipped by the lookup until then.
+//
+static void Bytecode_rebuild_constants(Bytecode* bytecode) {
+    ConstantIndex* constants = &bytecode->constants;
+
+    int capacity = 16;
+    while (capacity < (bytecode->values.count + 1) * 2) capacity *= 2;
+
+    Memory_FreeArray(int, constants->slots, constants->capacity);
+    constants->slots    = Memory_AllocateArray(int, NULL, 0, capacity);
+    constants->capacity = capacity;
+    constants->count    = 0;
+    assert(constants->slots);
+    memset(constants->slots, 0, sizeof(int) * capacity);
+
+    for (int i = 0; i < bytecode->values.count; i++) {
+        Value value = bytecode->values.items[i];
+        if (!value_is_number(value) && !value_is_object(value)) continue;
+
+        uint32_t slot = Bytecode_hash_constant(value) & (capacity - 1);
+        while (constants->slots[slot] != 0) slot = (slot + 1) & (capacity - 1);
+
+        constants->slots[slot] = i + 1;
+        constants->count += 1;
+    }
+}
+
+// Returns the index of 'value' in 'values', inserting it the first time.
+//
+int Bytecode_insert_value(Bytecode* bytecode, Value value) {
+    if (!value_is_number(value) && !value_is_object(value))
+        return ArrayValue_insert(&bytecode->values, value);
+
+    ConstantIndex* constants = &bytecode->constants;
+    if ((constants->count + 1) * 4 > constants->capacity * 3)
+        Bytecode_rebuild_constants(bytecode);
+
+    uint32_t mask = constants->capacity - 1;
+    uint32_t slot = Bytecode_hash_constant(value) & mask;
+    for (;; slot = (slot + 1) & mask) {
+        int value_index = constants->slots[slot] - 1;
+        if (value_index == -1) break;
+
+        if (
+            value_index < bytecode->values.count &&
+            Bytecode_is_same_constant(bytecode->values.items[value_index], value)
+        ) {
+            return value_index;
+        }
+    }
+
+    int value_index = ArrayValue_insert(&bytecode->values, value);
+    constants->slots[slot] = value_index + 1;
+    constants->count += 1;
+
+    return value_index;
+}
+
+void Bytecode_free_constants(Bytecode* bytecode) {
+    Memory_FreeArray(int, bytecode->constants.slots, bytecode->constants.capacity);
+    bytecode->constants.slots    = NULL;
+    bytecode->constants.count    = 0;
+    bytecode->constants.capacity = 0;
 }
 
 int Bytecode_insert_instruction_1byte(Bytecode* bytecode, OpCode opcode, int line_number, bool debug_trace_on) {
@@ -86,8 +178,37 @@ static int Bytecode_insert_instruction_4bytes(Bytecode* bytecode, OpCode opcode,
     return bytecode->instructions.count - 1;
 }
 
+// Emits an instruction taking the index of a local or a heap-value, in its
+// '_Long' variant when the index doesn't fit in 1 byte.
+//
+int Bytecode_insert_instruction_index(Bytecode* bytecode, OpCode opcode, int index, int line_number, bool debug_trace_on) {
+    assert(index >= 0 && index <= UINT16_MAX);
+
+    if (index < 256) 
+        return Bytecode_insert_instruction_2bytes(bytecode, opcode, (uint8_t)index, line_number, debug_trace_on);
+
+    OpCode opcode_long = OpCode_Invalid;
+    switch (opcode)
+    {
+    case OpCode_Stack_Copy_From_idx_To_Top:  opcode_long = OpCode_Stack_Copy_From_idx_To_Top_Long;  break;
+    case OpCode_Stack_Copy_Top_To_Idx:       opcode_long = OpCode_Stack_Copy_Top_To_Idx_Long;       break;
+    case OpCode_Stack_Copy_From_Heap_To_Top: opcode_long = OpCode_Stack_Copy_From_Heap_To_Top_Long; break;
+    case OpCode_Stack_Move_Top_To_Heap:      opcode_long = OpCode_Stack_Move_Top_To_Heap_Long;      break;
+    default: assert(false && "Error: OpCode has no '_Long' variant.");
+    }
+
+    return Bytecode_insert_instruction_3bytes(
+        bytecode,
+        opcode_long,
+        (index >> 8) & 0xff,
+        index & 0xff,
+        line_number,
+        debug_trace_on
+    );
+}
+
 int Bytecode_insert_instruction_constant(Bytecode* bytecode, Value value, int line_number, bool debug_trace_on) {
-    int value_index = ArrayValue_insert(&bytecode->values, value);
+    int value_index = Bytecode_insert_value(bytecode, value);
     assert(value_index > -1);
 
     if (value_index < 256) {
@@ -96,7 +217,7 @@ int Bytecode_insert_instruction_constant(Bytecode* bytecode, Value value, int li
             OpCode_Stack_Push_Literal,      // OpCode
             (uint8_t)value_index,           // Operand
             line_number,
-            DEBUG_TRACE_INSTRUCTION
+            debug_trace_on
         );
     }
 
@@ -109,7 +230,7 @@ int Bytecode_insert_instruction_constant(Bytecode* bytecode, Value value, int li
         OpCode_Stack_Push_Literal_Long,     // OpCode
         byte1, byte2, byte3,                // Operand
         line_number,
-        DEBUG_TRACE_INSTRUCTION
+        debug_trace_on
     );
 }
 
@@ -126,44 +247,38 @@ void Bytecode_insert_instruction_closure(Bytecode* bytecode, Value value, ArrayO
             line_number,
             false   // DEBUG_TRACE_INSTRUCTION
         );
+    } else {
+        uint8_t byte1 = (value_index >> 0 & 0xff);
+        uint8_t byte2 = (value_index >> 8 & 0xff);
+        uint8_t byte3 = (value_index >> 16 & 0xff);
 
-        // for (int i = 0; i < object_fn->outsiders_count; i++) {
-        for (int i = 0; i < outsiders->count; i++) {
-            // Compile 1(one) Byte Instruction
-            //
-            Bytecode_insert_instruction_1byte(
-                bytecode,
-                outsiders->items[i].location,
-                line_number,
-                false
-            );
-    
-            // Compile 1(one) Byte Instruction
-            //
-            Bytecode_insert_instruction_1byte(
-                bytecode,
-                (uint8_t)outsiders->items[i].index,
-                line_number,
-                false
-            );
-        }
-
-        if (debug_trace_on) Bytecode_disassemble_instruction(bytecode, opcode_index);
-
-        return;
+        Bytecode_insert_instruction_4bytes(
+            bytecode,
+            OpCode_Stack_Push_Closure_Long,      // OpCode
+            byte1, byte2, byte3,      // Operand
+            line_number,
+            false   // DEBUG_TRACE_INSTRUCTION
+        );
     }
 
-    uint8_t byte1 = (value_index >> 0 & 0xff);
-    uint8_t byte2 = (value_index >> 8 & 0xff);
-    uint8_t byte3 = (value_index >> 16 & 0xff);
+    // NOTE: Each outsider is its location and its index. An index past 255
+    //       takes 2 bytes and sets 'LOCAL_LOCATION_INDEX_LONG' on the
+    //       location.
+    //
+    // for (int i = 0; i < object_fn->outsiders_count; i++) {
+    for (int i = 0; i < outsiders->count; i++) {
+        Outsider* outsider = &outsiders->items[i];
+        if (outsider->index < 256) {
+            Bytecode_insert_instruction_1byte(bytecode, outsider->location, line_number, false);
+            Bytecode_insert_instruction_1byte(bytecode, (uint8_t)outsider->index, line_number, false);
+        } else {
+            Bytecode_insert_instruction_1byte(bytecode, outsider->location | LOCAL_LOCATION_INDEX_LONG, line_number, false);
+            Bytecode_insert_instruction_1byte(bytecode, (outsider->index >> 8) & 0xff, line_number, false);
+            Bytecode_insert_instruction_1byte(bytecode, outsider->index & 0xff, line_number, false);
+        }
+    }
 
-    Bytecode_insert_instruction_4bytes(
-        bytecode,
-        OpCode_Stack_Push_Closure_Long,      // OpCode
-        byte1, byte2, byte3,      // Operand
-        line_number,
-        DEBUG_TRACE_INSTRUCTION
-    );
+    if (debug_trace_on) Bytecode_disassemble_instruction(bytecode, opcode_index);
 }
 
 // Jumps Forward
@@ -179,28 +294,346 @@ int Bytecode_insert_instruction_jump(Bytecode* bytecode, OpCode opcode, int line
 
 // Jumps Backwards
 //
-void Bytecode_emit_instruction_loop(Bytecode* bytecode, int jump_to_index, int line_number, bool debug_trace_on) {
+// Returns true if the loop's body is too large.
+//
+bool Bytecode_emit_instruction_loop(Bytecode* bytecode, int jump_to_index, int line_number, bool debug_trace_on) {
     // instruction_array_current_position + loop_instruction_size(3 bytes) - increment_index_in_instruction_array
     //
     int instruction_start = bytecode->instructions.count;
     int instruction_length = 3;
     int offset = instruction_start + instruction_length - jump_to_index;
-    uint8_t operand_byte1 = ((offset >> 8) & 0xff);
-    uint8_t operand_byte2 = (offset & 0xff);
 
     Bytecode_insert_instruction_1byte(bytecode, OpCode_Loop, line_number, false);
-    Bytecode_insert_instruction_1byte(bytecode, operand_byte1, line_number, false);
-    Bytecode_insert_instruction_1byte(bytecode, operand_byte2, line_number, false);
+    Bytecode_insert_instruction_1byte(bytecode, 0xff, line_number, false);
+    Bytecode_insert_instruction_1byte(bytecode, 0xff, line_number, false);
+    bool error = !Bytecode_write_jump_distance(bytecode, instruction_start, offset);
 
     if (debug_trace_on) Bytecode_disassemble_instruction(bytecode, instruction_start);
+
+    return error;
+}
+
+// The opcode a jump or a loop has when its distance fits in the operand.
+//
+OpCode Bytecode_get_jump_short_form(OpCode opcode) {
+    switch (opcode)
+    {
+    case OpCode_Jump_If_False_Long: return OpCode_Jump_If_False;
+    case OpCode_Jump_If_True_Long:  return OpCode_Jump_If_True;
+    case OpCode_Jump_Long:          return OpCode_Jump;
+    case OpCode_Loop_Long:          return OpCode_Loop;
+    default:                        return opcode;
+    }
+}
+
+static OpCode Bytecode_get_jump_long_form(OpCode opcode) {
+    switch (opcode)
+    {
+    case OpCode_Jump_If_False: return OpCode_Jump_If_False_Long;
+    case OpCode_Jump_If_True:  return OpCode_Jump_If_True_Long;
+    case OpCode_Jump:          return OpCode_Jump_Long;
+    case OpCode_Loop:          return OpCode_Loop_Long;
+    default:                   return opcode;
+    }
+}
+
+// Distance, in bytes from the end of the instruction, of the jump or loop at
+// 'offset'.
+//
+int Bytecode_read_jump_distance(Bytecode* bytecode, int offset) {
+    uint8_t* instruction = bytecode->instructions.items + offset;
+    int operand = (instruction[1] << 8) | instruction[2];
+    if (Bytecode_get_jump_short_form(instruction[0]) == instruction[0]) return operand;
+
+    return (int)value_as_number(bytecode->values.items[operand]);
+}
+
+// Writes the distance of the jump or loop at 'offset', switching it to its
+// '_Long' form when the distance doesn't fit in the operand (and back when
+// it does). Returns false if the distance can't be stored.
+//
+// NOTE: Each long jump appends its own number to 'values', the optimizer
+//       rewrites the distances and two jumps must not share it.
+//
+bool Bytecode_write_jump_distance(Bytecode* bytecode, int offset, int distance) {
+    uint8_t* instruction = bytecode->instructions.items + offset;
+    OpCode opcode = Bytecode_get_jump_short_form(instruction[0]);
+
+    int operand = distance;
+    if (distance > UINT16_MAX) {
+        operand = ArrayValue_insert(&bytecode->values, value_make_number(distance));
+        if (operand > UINT16_MAX) return false;
+
+        opcode = Bytecode_get_jump_long_form(opcode);
+    }
+
+    instruction[0] = opcode;
+    instruction[1] = (operand >> 8) & 0xff;
+    instruction[2] = operand & 0xff;
+
+    return true;
+}
+
+// If the instruction at 'offset' pushes a constant (a literal or a value from
+// the pool), writes it to 'value_out' and returns the instruction size,
+// otherwise returns 0.
+//
+int Bytecode_read_constant(Bytecode* bytecode, int offset, Value* value_out) {
+    uint8_t* instruction = bytecode->instructions.items + offset;
+    switch (instruction[0])
+    {
+    default: return 0;
+    case OpCode_Stack_Push_Literal_Nil:   *value_out = value_make_nil();          return 1;
+    case OpCode_Stack_Push_Literal_True:  *value_out = value_make_boolean(true);  return 1;
+    case OpCode_Stack_Push_Literal_False: *value_out = value_make_boolean(false); return 1;
+    case OpCode_Stack_Push_Literal: {
+        *value_out = bytecode->values.items[instruction[1]];
+        return 2;
+    }
+    case OpCode_Stack_Push_Literal_Long: {
+        uint32_t value_index = (uint32_t)((((instruction[1] << 8) | instruction[2]) << 8) | instruction[3]);
+        *value_out = bytecode->values.items[value_index];
+        return 4;
+    }
+    }
+}
+
+// Drops the instructions from 'instruction_count' on (with their lines) and
+// the values from 'value_count' on.
+//
+// NOTE: Only safe when nothing before 'instruction_count' jumps past it and
+//       no instruction before it uses the values that are dropped.
+//
+void Bytecode_truncate(Bytecode* bytecode, int instruction_count, int value_count) {
+    assert(instruction_count <= bytecode->instructions.count);
+    assert(value_count       <= bytecode->values.count);
+
+    bytecode->instructions.count = instruction_count;
+    bytecode->lines.count        = instruction_count;
+    bytecode->values.count       = value_count;
+}
+
+// Size in bytes of the outsiders that follow a closure instruction.
+//
+static int Bytecode_get_outsiders_size(uint8_t* outsiders, int outsiders_count) {
+    int size = 0;
+    for (int i = 0; i < outsiders_count; i++)
+        size += (outsiders[size] & LOCAL_LOCATION_INDEX_LONG) ? 3 : 2;
+
+    return size;
+}
+
+// Size in bytes, operands included, of the instruction at 'offset'.
+//
+int Bytecode_get_instruction_size(Bytecode* bytecode, int offset) {
+    uint8_t* instruction = bytecode->instructions.items + offset;
+    switch (instruction[0])
+    {
+    default: {
+        assert(false && "Error: Unhandled OpCode.");
+        return 1;
+    }
+    case OpCode_Stack_Push_Literal_Nil:
+    case OpCode_Stack_Push_Literal_True:
+    case OpCode_Stack_Push_Literal_False:
+    case OpCode_Stack_Move_Value_To_Heap:
+    case OpCode_Stack_Pop:
+    case OpCode_Negation:
+    case OpCode_Not:
+    case OpCode_Add:
+    case OpCode_Subtract:
+    case OpCode_Multiply:
+    case OpCode_Divide:
+    case OpCode_Exponentiation:
+    case OpCode_Equal_To:
+    case OpCode_Greater_Than:
+    case OpCode_Less_Than:
+    case OpCode_Print:
+    case OpCode_Inheritance:
+    case OpCode_Return:
+    case OpCode_Debugger_Break:
+        return 1;
+    case OpCode_Stack_Push_Literal:
+    case OpCode_Stack_Copy_From_idx_To_Top:
+    case OpCode_Stack_Copy_Top_To_Idx:
+    case OpCode_Stack_Copy_From_Heap_To_Top:
+    case OpCode_Stack_Move_Top_To_Heap:
+    case OpCode_Interpolation:
+    case OpCode_Define_Global:
+    case OpCode_Read_Global:
+    case OpCode_Assign_Global:
+    case OpCode_Call_Function:
+    case OpCode_Call_Function_Tail:
+    case OpCode_Call_Class:
+    case OpCode_Class:
+    case OpCode_Method:
+    case OpCode_Object_Set_Property:
+    case OpCode_Object_Get_Property:
+    case OpCode_Get_Super:
+        return 2;
+    case OpCode_Stack_Copy_From_idx_To_Top_Long:
+    case OpCode_Stack_Copy_Top_To_Idx_Long:
+    case OpCode_Stack_Copy_From_Heap_To_Top_Long:
+    case OpCode_Stack_Move_Top_To_Heap_Long:
+    case OpCode_Jump_If_False:
+    case OpCode_Jump_If_False_Long:
+    case OpCode_Jump_If_True:
+    case OpCode_Jump_If_True_Long:
+    case OpCode_Jump:
+    case OpCode_Jump_Long:
+    case OpCode_Loop:
+    case OpCode_Loop_Long:
+    case OpCode_Call_Method:
+    case OpCode_Call_Method_Tail:
+    case OpCode_Call_Super_Method:
+    case OpCode_Call_Super_Method_Tail:
+        return 3;
+    case OpCode_Stack_Push_Literal_Long:
+        return 4;
+    case OpCode_Stack_Push_Closure: {
+        ObjectFunction* function = value_as_function_object(bytecode->values.items[instruction[1]]);
+        return 2 + Bytecode_get_outsiders_size(instruction + 2, function->outsiders_count);
+    }
+    case OpCode_Stack_Push_Closure_Long: {
+        uint32_t value_index = (uint32_t)((((instruction[1] << 8) | instruction[2]) << 8) | instruction[3]);
+        ObjectFunction* function = value_as_function_object(bytecode->values.items[value_index]);
+        return 4 + Bytecode_get_outsiders_size(instruction + 4, function->outsiders_count);
+    }
+    }
+}
+
+// How many values the instruction leaves on the Stack, minus how many it
+// takes. A call counts as the callee and its arguments replaced by the
+// result, the callee's own frame is reserved when it's called.
+//
+static int Bytecode_get_stack_effect(uint8_t* instruction) {
+    switch (instruction[0])
+    {
+    default: {
+        assert(false && "Error: Unhandled OpCode.");
+        return 0;
+    }
+    case OpCode_Stack_Push_Literal:
+    case OpCode_Stack_Push_Literal_Long:
+    case OpCode_Stack_Push_Literal_Nil:
+    case OpCode_Stack_Push_Literal_True:
+    case OpCode_Stack_Push_Literal_False:
+    case OpCode_Stack_Push_Closure:
+    case OpCode_Stack_Push_Closure_Long:
+    case OpCode_Stack_Copy_From_idx_To_Top:
+    case OpCode_Stack_Copy_From_idx_To_Top_Long:
+    case OpCode_Stack_Copy_From_Heap_To_Top:
+    case OpCode_Stack_Copy_From_Heap_To_Top_Long:
+    case OpCode_Read_Global:
+    case OpCode_Class:
+        return 1;
+    case OpCode_Stack_Copy_Top_To_Idx:
+    case OpCode_Stack_Copy_Top_To_Idx_Long:
+    case OpCode_Stack_Move_Top_To_Heap:
+    case OpCode_Stack_Move_Top_To_Heap_Long:
+    case OpCode_Negation:
+    case OpCode_Not:
+    case OpCode_Jump_If_False:
+    case OpCode_Jump_If_False_Long:
+    case OpCode_Jump_If_True:
+    case OpCode_Jump_If_True_Long:
+    case OpCode_Jump:
+    case OpCode_Jump_Long:
+    case OpCode_Loop:
+    case OpCode_Loop_Long:
+    case OpCode_Assign_Global:
+    case OpCode_Object_Get_Property:
+    case OpCode_Return:
+    case OpCode_Debugger_Break:
+        return 0;
+    case OpCode_Stack_Move_Value_To_Heap:
+    case OpCode_Stack_Pop:
+    case OpCode_Add:
+    case OpCode_Subtract:
+    case OpCode_Multiply:
+    case OpCode_Divide:
+    case OpCode_Exponentiation:
+    case OpCode_Equal_To:
+    case OpCode_Greater_Than:
+    case OpCode_Less_Than:
+    case OpCode_Print:
+    case OpCode_Define_Global:
+    case OpCode_Method:
+    case OpCode_Inheritance:
+    case OpCode_Object_Set_Property:
+    case OpCode_Get_Super:
+        return -1;
+    case OpCode_Interpolation:
+        return 1 - instruction[1];
+    case OpCode_Call_Function:
+    case OpCode_Call_Function_Tail:
+    case OpCode_Call_Class:
+        return -instruction[1];
+    case OpCode_Call_Method:
+    case OpCode_Call_Method_Tail:
+        return -instruction[2];
+    case OpCode_Call_Super_Method:
+    case OpCode_Call_Super_Method_Tail:
+        return -instruction[2] - 1; // NOTE: The superclass is popped before the call
+    }
+}
+
+// Deepest the Stack gets while the function runs, counted from
+// 'frame_start' ('depth_start' is the callee and its parameters). Follows
+// every path through the jumps; the compiler keeps the depth the same on all
+// the paths that meet at an instruction, so each offset is visited once.
+//
+int Bytecode_get_max_stack_depth(Bytecode* bytecode, int depth_start) {
+    int count = bytecode->instructions.count;
+    if (count == 0) return depth_start;
+
+    int* depths  = (int*)malloc(sizeof(int) * count); // NOTE: -1 until an instruction is reached
+    int* pending = (int*)malloc(sizeof(int) * count);
+    assert(depths && pending);
+    for (int i = 0; i < count; i++) depths[i] = -1;
+
+    int pending_count = 0;
+    int depth_max     = depth_start;
+    depths[0] = depth_start;
+    pending[pending_count++] = 0;
+
+    while (pending_count > 0) {
+        int offset = pending[--pending_count];
+        uint8_t* instruction = bytecode->instructions.items + offset;
+        OpCode opcode = Bytecode_get_jump_short_form(instruction[0]);
+        int next = offset + Bytecode_get_instruction_size(bytecode, offset);
+
+        int depth = depths[offset] + Bytecode_get_stack_effect(instruction);
+        if (depth > depth_max) depth_max = depth;
+        if (opcode == OpCode_Return) continue;
+
+        int successors[2];
+        int successors_count = 0;
+        if (opcode == OpCode_Jump || opcode == OpCode_Jump_If_False || opcode == OpCode_Jump_If_True)
+            successors[successors_count++] = next + Bytecode_read_jump_distance(bytecode, offset);
+        if (opcode == OpCode_Loop)
+            successors[successors_count++] = next - Bytecode_read_jump_distance(bytecode, offset);
+        if (opcode != OpCode_Jump && opcode != OpCode_Loop)
+            successors[successors_count++] = next;
+
+        for (int i = 0; i < successors_count; i++) {
+            int successor = successors[i];
+            if (successor < 0 || successor >= count || depths[successor] != -1) continue;
+
+            depths[successor] = depth;
+            pending[pending_count++] = successor;
+        }
+    }
+
+    free(depths);
+    free(pending);
+
+    return depth_max;
 }
 
 bool Bytecode_patch_instruction_jump(Bytecode* bytecode, int operand_index, bool debug_trace_on) {
     int jump_to_index = bytecode->instructions.count - operand_index - 2;
-    if (jump_to_index > UINT16_MAX) return true;
-
-    bytecode->instructions.items[operand_index] = (jump_to_index >> 8) & 0xff;
-    bytecode->instructions.items[operand_index + 1] = jump_to_index & 0xff;
+    if (!Bytecode_write_jump_distance(bytecode, operand_index - 1, jump_to_index)) return true;
 
     if (debug_trace_on) {
         printf(">> PATCH JUMP:\n");
@@ -226,6 +659,8 @@ int Bytecode_debug_decrease_indentation() {
 }
 
 void Bytecode_debug_print(const char* format, ...) {
+    if (!DEBUG_TRACE_INSTRUCTION) return;
+
     FILE* stream = stdout;
     va_list arguments;
     va_start(arguments, format);
@@ -274,8 +709,14 @@ static int Bytecode_debug_instruction_call_method(Bytecode* bytecode, const char
     return ret_offset_increment;
 }
 
-static int Bytecode_debug_instruction_closure(Bytecode* bytecode, const char* opcode_text, int ret_offset_increment) {
-    uint8_t operand = bytecode->instructions.items[ret_offset_increment - 1];
+static int Bytecode_debug_instruction_closure(Bytecode* bytecode, const char* opcode_text, int offset) {
+    uint8_t* instruction = bytecode->instructions.items + offset;
+    uint32_t operand = instruction[1];
+    int ret_offset_increment = offset + 2;
+    if (instruction[0] == OpCode_Stack_Push_Closure_Long) {
+        operand = (uint32_t)((((instruction[1] << 8) | instruction[2]) << 8) | instruction[3]);
+        ret_offset_increment = offset + 4;
+    }
     Value value = bytecode->values.items[operand];
 
     printf("%-45s %5d '", opcode_text, operand);
@@ -284,10 +725,15 @@ static int Bytecode_debug_instruction_closure(Bytecode* bytecode, const char* op
 
     ObjectFunction* function = value_as_function_object(value);
     for (int i = 0; i < function->outsiders_count; i++) {
+        int outsider_offset = ret_offset_increment;
         int local_location = bytecode->instructions.items[ret_offset_increment++];
         int index = bytecode->instructions.items[ret_offset_increment++];
+        if (local_location & LOCAL_LOCATION_INDEX_LONG) {
+            local_location &= ~LOCAL_LOCATION_INDEX_LONG;
+            index = (index << 8) | bytecode->instructions.items[ret_offset_increment++];
+        }
 
-        printf("%04d      | %2s ", ret_offset_increment - 2, "");
+        printf("%04d      | %2s ", outsider_offset, "");
         if (local_location == LocalLocation_In_Parent_Stack) {
             printf("%d) New heap-value from parent's stack index '%d'.\n", i + 1,  index);
         }
@@ -308,6 +754,15 @@ static int Bytecode_debug_instruction_local(Bytecode* bytecode, const char* opco
     return ret_offset_increment;
 }
 
+static int Bytecode_debug_instruction_local_long(Bytecode* bytecode, const char* opcode_text, int ret_offset_increment)
+{
+    uint8_t operand_byte1 = bytecode->instructions.items[ret_offset_increment - 2];
+    uint8_t operand_byte2 = bytecode->instructions.items[ret_offset_increment - 1];
+
+    printf("%-45s %5d\n", opcode_text, (operand_byte1 << 8) | operand_byte2);
+    return ret_offset_increment;
+}
+
 // TODO: rename to bytecode_debug_instruction_jump(bytecode, text, sign, offset);
 //
 static int Bytecode_debug_instruction_3bytes(Bytecode* bytecode, const char* opcode_text, int ret_offset_increment) {
@@ -322,10 +777,8 @@ static int Bytecode_debug_instruction_3bytes(Bytecode* bytecode, const char* opc
 }
 
 static int Bytecode_debug_instruction_jump(Bytecode* bytecode, const char* text, int sign, int ret_offset_increment) {
-    uint8_t operand_byte1 = bytecode->instructions.items[ret_offset_increment - 2];
-    uint8_t operand_byte2 = bytecode->instructions.items[ret_offset_increment - 1];
-    uint16_t operand_value = (uint16_t)((operand_byte1 << 8) | operand_byte2);
     int current_offset = ret_offset_increment - 3;
+    int operand_value = Bytecode_read_jump_distance(bytecode, current_offset);
 
     printf("%-45s %5d -> %d\n", text, current_offset, ret_offset_increment + operand_value * sign);
 
@@ -460,9 +913,9 @@ int Bytecode_disassemble_instruction(Bytecode* bytecode, int offset)
     if (opcode == OpCode_Stack_Push_Literal_False)
         return Bytecode_debug_instruction_byte("OPCODE_STACK_PUSH_LITERAL_FALSE", (offset + 1));
     if (opcode == OpCode_Stack_Push_Closure)
-        return Bytecode_debug_instruction_closure(bytecode, "OPCODE_STACK_PUSH_CLOSURE", (offset + 2));
+        return Bytecode_debug_instruction_closure(bytecode, "OPCODE_STACK_PUSH_CLOSURE", offset);
     if (opcode == OpCode_Stack_Push_Closure_Long)
-        return Bytecode_debug_instruction_closure(bytecode, "OPCODE_STACK_PUSH_CLOSURE_LONG", (offset + 4));
+        return Bytecode_debug_instruction_closure(bytecode, "OPCODE_STACK_PUSH_CLOSURE_LONG", offset);
     if (opcode == OpCode_Stack_Copy_From_idx_To_Top)
         return Bytecode_debug_instruction_local(bytecode, "OPCODE_STACK_COPY_FROM_IDX_TO_TOP", (offset + 2));
     if (opcode == OpCode_Stack_Copy_Top_To_Idx)
@@ -471,6 +924,14 @@ int Bytecode_disassemble_instruction(Bytecode* bytecode, int offset)
         return Bytecode_debug_instruction_local(bytecode, "OPCODE_STACK_COPY_FROM_HEAP_TO_TOP", (offset + 2));
     if (opcode == OpCode_Stack_Move_Top_To_Heap)
         return Bytecode_debug_instruction_local(bytecode, "OPCODE_STACK_MOVE_TOP_TO_HEAP", (offset + 2));
+    if (opcode == OpCode_Stack_Copy_From_idx_To_Top_Long)
+        return Bytecode_debug_instruction_local_long(bytecode, "OPCODE_STACK_COPY_FROM_IDX_TO_TOP_LONG", (offset + 3));
+    if (opcode == OpCode_Stack_Copy_Top_To_Idx_Long)
+        return Bytecode_debug_instruction_local_long(bytecode, "OPCODE_STACK_COPY_TOP_TO_IDX_LONG", (offset + 3));
+    if (opcode == OpCode_Stack_Copy_From_Heap_To_Top_Long)
+        return Bytecode_debug_instruction_local_long(bytecode, "OPCODE_STACK_COPY_FROM_HEAP_TO_TOP_LONG", (offset + 3));
+    if (opcode == OpCode_Stack_Move_Top_To_Heap_Long)
+        return Bytecode_debug_instruction_local_long(bytecode, "OPCODE_STACK_MOVE_TOP_TO_HEAP_LONG", (offset + 3));
     if (opcode == OpCode_Stack_Move_Value_To_Heap)
         return Bytecode_debug_instruction_byte("OPCODE_STACK_MOVE_VALUE_TO_HEAP", (offset + 1));
     if (opcode == OpCode_Interpolation)
@@ -497,12 +958,18 @@ int Bytecode_disassemble_instruction(Bytecode* bytecode, int offset)
         return Bytecode_debug_instruction_2bytes(bytecode, "OPCODE_ASSIGN_GLOBAL", (offset + 2));
     if (opcode == OpCode_Call_Function)
         return Bytecode_debug_instruction_call(bytecode, "OPCODE_CALL_FUNCTION", (offset + 2));
+    if (opcode == OpCode_Call_Function_Tail)
+        return Bytecode_debug_instruction_call(bytecode, "OPCODE_CALL_FUNCTION_TAIL", (offset + 2));
     if (opcode == OpCode_Call_Class)
         return Bytecode_debug_instruction_call(bytecode, "OPCODE_CALL_CLASS", (offset + 2));
     if (opcode == OpCode_Call_Method)
         return Bytecode_debug_instruction_call_method(bytecode, "OPCODE_CALL_METHOD", (offset + 3));
+    if (opcode == OpCode_Call_Method_Tail)
+        return Bytecode_debug_instruction_call_method(bytecode, "OPCODE_CALL_METHOD_TAIL", (offset + 3));
     if (opcode == OpCode_Call_Super_Method)
         return Bytecode_debug_instruction_call_method(bytecode, "OPCODE_CALL_SUPER_METHOD", (offset + 3));
+    if (opcode == OpCode_Call_Super_Method_Tail)
+        return Bytecode_debug_instruction_call_method(bytecode, "OPCODE_CALL_SUPER_METHOD_TAIL", (offset + 3));
     if (opcode == OpCode_Negation)
         return Bytecode_debug_instruction_byte("OPCODE_NEGATION", (offset + 1));
     if (opcode == OpCode_Not)
@@ -529,10 +996,20 @@ int Bytecode_disassemble_instruction(Bytecode* bytecode, int offset)
         return Bytecode_debug_instruction_byte("OPCODE_PRINT", (offset + 1));
     if (opcode == OpCode_Jump_If_False)
         return Bytecode_debug_instruction_jump(bytecode, "OPCODE_JUMP_IF_FALSE", 1, (offset + 3));
+    if (opcode == OpCode_Jump_If_True)
+        return Bytecode_debug_instruction_jump(bytecode, "OPCODE_JUMP_IF_TRUE", 1, (offset + 3));
     if (opcode == OpCode_Jump)
         return Bytecode_debug_instruction_jump(bytecode, "OPCODE_JUMP", 1, (offset + 3));
     if (opcode == OpCode_Loop)
         return Bytecode_debug_instruction_jump(bytecode, "OPCODE_LOOP", -1, (offset + 3));
+    if (opcode == OpCode_Jump_If_False_Long)
+        return Bytecode_debug_instruction_jump(bytecode, "OPCODE_JUMP_IF_FALSE_LONG", 1, (offset + 3));
+    if (opcode == OpCode_Jump_If_True_Long)
+        return Bytecode_debug_instruction_jump(bytecode, "OPCODE_JUMP_IF_TRUE_LONG", 1, (offset + 3));
+    if (opcode == OpCode_Jump_Long)
+        return Bytecode_debug_instruction_jump(bytecode, "OPCODE_JUMP_LONG", 1, (offset + 3));
+    if (opcode == OpCode_Loop_Long)
+        return Bytecode_debug_instruction_jump(bytecode, "OPCODE_LOOP_LONG", -1, (offset + 3));
     if (opcode == OpCode_Return)
         return Bytecode_debug_instruction_byte("OPCODE_RETURN", (offset + 1));
     if (opcode == OpCode_Debugger_Break)
@@ -568,4 +1045,5 @@ void Bytecode_free(Bytecode* bytecode) {
     array_instruction_free(&bytecode->instructions);
     array_line_free(&bytecode->lines);
     ArrayValue_free(&bytecode->values);
+    Bytecode_free_constants(bytecode);
 }
\ No newline at end of file
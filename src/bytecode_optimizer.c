@@ -0,0 +1,432 @@
+#include "kriolu.h"
+
+// Bytecode Optimizer
+//
+// Peephole pass over a finished function. The instructions are decoded into
+// a list, the patterns below rewrite or remove entries of that list until
+// nothing changes, and the bytecode is written back with the jumps, the
+// lines and the source code offsets moved to where their instructions went.
+//
+// Patterns:
+//     push, pop                      -> (nothing)
+//     store x, pop, load x           -> store x
+//     jump to a jump                 -> jump to the final target
+//     jump to the next instruction   -> (nothing)
+//     not, jump_if_false             -> jump_if_true (both paths start with a pop)
+//     not, jump_if_true              -> jump_if_false (same)
+//     constant, jump_if_false        -> constant, jump (or nothing, if the constant is truthy)
+//     push, jump to a pop            -> jump past the pop
+//
+// An instruction that a jump lands on is never merged with the one before
+// it, the jump would skip half of the pattern.
+//
+// The '_Long' jumps are decoded to their short opcode, the encoder picks the
+// form again from the final distance.
+//
+// After each round the instructions that can't be reached from the start of
+// the function are removed: the code after 'divolvi', 'sai' and 'salta',
+// and the branches a constant condition never takes.
+//
+
+typedef struct {
+    int offset;         // NOTE: Offset in the bytecode as emitted
+    int size;
+    int target;         // NOTE: Index of the instruction a jump lands on, -1 if not a jump
+    int jumps_in;       // NOTE: How many jumps land on this instruction
+    bool is_removed;
+} OptimizerInstruction;
+
+typedef struct {
+    Bytecode* bytecode;
+    OptimizerInstruction* items;
+    int count;
+    int* index_of_offset;   // NOTE: Instruction at each emitted offset, operand bytes map to the next one
+} Optimizer;
+
+static bool Optimizer_is_jump_forward(uint8_t opcode) {
+    if (opcode == OpCode_Jump)          return true;
+    if (opcode == OpCode_Jump_If_False) return true;
+    if (opcode == OpCode_Jump_If_True)  return true;
+
+    return false;
+}
+
+static bool Optimizer_is_push_without_side_effects(uint8_t opcode) {
+    if (opcode == OpCode_Stack_Push_Literal)            return true;
+    if (opcode == OpCode_Stack_Push_Literal_Long)       return true;
+    if (opcode == OpCode_Stack_Push_Literal_Nil)        return true;
+    if (opcode == OpCode_Stack_Push_Literal_True)       return true;
+    if (opcode == OpCode_Stack_Push_Literal_False)      return true;
+    if (opcode == OpCode_Stack_Copy_From_idx_To_Top)         return true;
+    if (opcode == OpCode_Stack_Copy_From_idx_To_Top_Long)    return true;
+    if (opcode == OpCode_Stack_Copy_From_Heap_To_Top)        return true;
+    if (opcode == OpCode_Stack_Copy_From_Heap_To_Top_Long)   return true;
+
+    return false;
+}
+
+// The load that reads back what 'store_opcode' wrote, OpCode_Invalid if none.
+//
+static uint8_t Optimizer_get_load_of_store(uint8_t store_opcode) {
+    if (store_opcode == OpCode_Stack_Copy_Top_To_Idx)       return OpCode_Stack_Copy_From_idx_To_Top;
+    if (store_opcode == OpCode_Stack_Copy_Top_To_Idx_Long)  return OpCode_Stack_Copy_From_idx_To_Top_Long;
+    if (store_opcode == OpCode_Stack_Move_Top_To_Heap)      return OpCode_Stack_Copy_From_Heap_To_Top;
+    if (store_opcode == OpCode_Stack_Move_Top_To_Heap_Long) return OpCode_Stack_Copy_From_Heap_To_Top_Long;
+    if (store_opcode == OpCode_Assign_Global)               return OpCode_Read_Global;
+
+    return OpCode_Invalid;
+}
+
+static uint8_t* Optimizer_get_bytes(Optimizer* optimizer, int index) {
+    return optimizer->bytecode->instructions.items + optimizer->items[index].offset;
+}
+
+// First instruction at or after 'index' that wasn't removed, 'count' if none.
+//
+static int Optimizer_next(Optimizer* optimizer, int index) {
+    while (index < optimizer->count && optimizer->items[index].is_removed)
+        index += 1;
+
+    return index;
+}
+
+static uint8_t Optimizer_get_opcode(Optimizer* optimizer, int index) {
+    if (index >= optimizer->count) return OpCode_Invalid;
+
+    return Optimizer_get_bytes(optimizer, index)[0];
+}
+
+// Where the jump at 'index' lands, skipping the instructions removed since.
+//
+static int Optimizer_get_target(Optimizer* optimizer, int index) {
+    OptimizerInstruction* instruction = &optimizer->items[index];
+    instruction->target = Optimizer_next(optimizer, instruction->target);
+
+    return instruction->target;
+}
+
+// NOTE: The jumps that landed on a removed instruction land on the next
+//       one left, so it takes over their count.
+//
+static void Optimizer_remove(Optimizer* optimizer, int index) {
+    OptimizerInstruction* instruction = &optimizer->items[index];
+    if (instruction->target != -1)
+        optimizer->items[Optimizer_get_target(optimizer, index)].jumps_in -= 1;
+
+    instruction->is_removed = true;
+    optimizer->items[Optimizer_next(optimizer, index + 1)].jumps_in += instruction->jumps_in;
+    instruction->jumps_in = 0;
+}
+
+static void Optimizer_retarget(Optimizer* optimizer, int index, int target) {
+    optimizer->items[Optimizer_get_target(optimizer, index)].jumps_in -= 1;
+    optimizer->items[target].jumps_in += 1;
+    optimizer->items[index].target = target;
+}
+
+static void Optimizer_decode(Optimizer* optimizer, Bytecode* bytecode) {
+    int instructions_count = bytecode->instructions.count;
+
+    // NOTE: One extra entry stands for the end of the bytecode, jumps past
+    //       the last instruction land on it.
+    //
+    optimizer->bytecode = bytecode;
+    optimizer->items    = (OptimizerInstruction*)calloc(instructions_count + 1, sizeof(OptimizerInstruction));
+    optimizer->count    = 0;
+    assert(optimizer->items);
+
+    int* index_of_offset = (int*)malloc(sizeof(int) * (instructions_count + 1));
+    optimizer->index_of_offset = index_of_offset;
+    assert(index_of_offset);
+
+    for (int offset = 0; offset < instructions_count;) {
+        OptimizerInstruction* instruction = &optimizer->items[optimizer->count];
+        instruction->offset = offset;
+        instruction->size   = Bytecode_get_instruction_size(bytecode, offset);
+        instruction->target = -1;
+        assert(offset + instruction->size <= instructions_count);
+
+        index_of_offset[offset] = optimizer->count;
+        for (int i = 1; i < instruction->size; i++)
+            index_of_offset[offset + i] = optimizer->count + 1;
+
+        optimizer->count += 1;
+        offset += instruction->size;
+    }
+    optimizer->items[optimizer->count].offset = instructions_count;
+    optimizer->items[optimizer->count].target = -1;
+    index_of_offset[instructions_count] = optimizer->count;
+
+    for (int i = 0; i < optimizer->count; i++) {
+        uint8_t* bytes = Optimizer_get_bytes(optimizer, i);
+        uint8_t opcode = Bytecode_get_jump_short_form(bytes[0]);
+        bool is_jump_forward = Optimizer_is_jump_forward(opcode);
+        if (!is_jump_forward && opcode != OpCode_Loop) continue;
+
+        int jump_distance = Bytecode_read_jump_distance(bytecode, optimizer->items[i].offset);
+        int next_offset = optimizer->items[i].offset + 3;
+        int target_offset = is_jump_forward
+            ? next_offset + jump_distance
+            : next_offset - jump_distance;
+        assert(target_offset >= 0 && target_offset <= instructions_count);
+
+        optimizer->items[i].target = index_of_offset[target_offset];
+        optimizer->items[optimizer->items[i].target].jumps_in += 1;
+        bytes[0] = opcode;
+    }
+}
+
+static bool Optimizer_rewrite_jump(Optimizer* optimizer, int index) {
+    uint8_t opcode = Optimizer_get_opcode(optimizer, index);
+    if (!Optimizer_is_jump_forward(opcode)) return false;
+
+    int next   = Optimizer_next(optimizer, index + 1);
+    int target = Optimizer_get_target(optimizer, index);
+
+    // NOTE: Conditional jumps only peek the condition, so one that lands
+    //       right after itself does nothing either.
+    //
+    if (target == next) {
+        Optimizer_remove(optimizer, index);
+        return true;
+    }
+
+    // NOTE: A conditional jump landing on another one with the same opcode
+    //       sees the same condition, so it takes that one too.
+    //
+    int hops = 0;
+    for (;;) {
+        uint8_t target_opcode = Optimizer_get_opcode(optimizer, target);
+        if (target_opcode != OpCode_Jump && target_opcode != opcode) break;
+        if (hops++ == optimizer->count) break;
+
+        target = Optimizer_get_target(optimizer, target);
+    }
+
+    if (target == optimizer->items[index].target) return false;
+
+    Optimizer_retarget(optimizer, index, target);
+    return true;
+}
+
+static bool Optimizer_rewrite_push_pop(Optimizer* optimizer, int index) {
+    if (!Optimizer_is_push_without_side_effects(Optimizer_get_opcode(optimizer, index))) return false;
+
+    int pop = Optimizer_next(optimizer, index + 1);
+    if (Optimizer_get_opcode(optimizer, pop) != OpCode_Stack_Pop) return false;
+    if (optimizer->items[pop].jumps_in > 0)                       return false;
+
+    Optimizer_remove(optimizer, index);
+    Optimizer_remove(optimizer, pop);
+    return true;
+}
+
+static bool Optimizer_rewrite_store_pop_load(Optimizer* optimizer, int index) {
+    uint8_t* store = Optimizer_get_bytes(optimizer, index);
+    uint8_t load_opcode = Optimizer_get_load_of_store(store[0]);
+    if (load_opcode == OpCode_Invalid) return false;
+
+    int pop  = Optimizer_next(optimizer, index + 1);
+    int load = Optimizer_next(optimizer, pop + 1);
+    if (Optimizer_get_opcode(optimizer, pop) != OpCode_Stack_Pop)    return false;
+    if (Optimizer_get_opcode(optimizer, load) != load_opcode)        return false;
+    if (memcmp(Optimizer_get_bytes(optimizer, load) + 1, store + 1, optimizer->items[index].size - 1) != 0) return false;
+    if (optimizer->items[pop].jumps_in > 0)                          return false;
+    if (optimizer->items[load].jumps_in > 0)                         return false;
+
+    Optimizer_remove(optimizer, pop);
+    Optimizer_remove(optimizer, load);
+    return true;
+}
+
+static bool Optimizer_rewrite_not_jump(Optimizer* optimizer, int index) {
+    if (Optimizer_get_opcode(optimizer, index) != OpCode_Not) return false;
+    if (optimizer->items[index].jumps_in > 0)                 return false;
+
+    int jump = Optimizer_next(optimizer, index + 1);
+    uint8_t jump_opcode = Optimizer_get_opcode(optimizer, jump);
+    if (jump_opcode != OpCode_Jump_If_False && jump_opcode != OpCode_Jump_If_True) return false;
+    if (optimizer->items[jump].jumps_in > 0)                                        return false;
+
+    // NOTE: The condition stays on the Stack after the jump, without the
+    //       'not' it's the opposite value, so both paths must drop it.
+    //
+    int fallthrough = Optimizer_next(optimizer, jump + 1);
+    int target      = Optimizer_get_target(optimizer, jump);
+    if (Optimizer_get_opcode(optimizer, fallthrough) != OpCode_Stack_Pop) return false;
+    if (Optimizer_get_opcode(optimizer, target) != OpCode_Stack_Pop)      return false;
+
+    Optimizer_remove(optimizer, index);
+    Optimizer_get_bytes(optimizer, jump)[0] = jump_opcode == OpCode_Jump_If_False
+        ? OpCode_Jump_If_True
+        : OpCode_Jump_If_False;
+    return true;
+}
+
+static bool Optimizer_rewrite_constant_condition(Optimizer* optimizer, int index) {
+    Value condition = { 0 };
+    if (Bytecode_read_constant(optimizer->bytecode, optimizer->items[index].offset, &condition) == 0) return false;
+
+    int jump = Optimizer_next(optimizer, index + 1);
+    uint8_t jump_opcode = Optimizer_get_opcode(optimizer, jump);
+    if (jump_opcode != OpCode_Jump_If_False && jump_opcode != OpCode_Jump_If_True) return false;
+    if (optimizer->items[jump].jumps_in > 0)                                        return false;
+
+    bool is_taken = (jump_opcode == OpCode_Jump_If_False) == value_is_falsey(condition);
+    if (is_taken)
+        Optimizer_get_bytes(optimizer, jump)[0] = OpCode_Jump;
+    else
+        Optimizer_remove(optimizer, jump);
+
+    return true;
+}
+
+static bool Optimizer_rewrite_push_jump_pop(Optimizer* optimizer, int index) {
+    if (!Optimizer_is_push_without_side_effects(Optimizer_get_opcode(optimizer, index))) return false;
+
+    int jump = Optimizer_next(optimizer, index + 1);
+    if (Optimizer_get_opcode(optimizer, jump) != OpCode_Jump) return false;
+    if (optimizer->items[jump].jumps_in > 0)                  return false;
+
+    int pop = Optimizer_get_target(optimizer, jump);
+    if (Optimizer_get_opcode(optimizer, pop) != OpCode_Stack_Pop) return false;
+
+    Optimizer_remove(optimizer, index);
+    Optimizer_retarget(optimizer, jump, Optimizer_next(optimizer, pop + 1));
+    return true;
+}
+
+// Removes what can't be reached from the first instruction, following the
+// jumps and falling through everything but 'jump', 'loop' and 'return'.
+//
+static bool Optimizer_remove_unreachable(Optimizer* optimizer) {
+    bool* is_reachable = (bool*)calloc(optimizer->count + 1, sizeof(bool));
+    int* pending = (int*)malloc(sizeof(int) * (2 * optimizer->count + 2));
+    assert(is_reachable);
+    assert(pending);
+
+    int pending_count = 0;
+    pending[pending_count++] = Optimizer_next(optimizer, 0);
+    while (pending_count > 0) {
+        int index = pending[--pending_count];
+        if (is_reachable[index]) continue;
+
+        is_reachable[index] = true;
+        if (index == optimizer->count) continue;
+
+        if (optimizer->items[index].target != -1)
+            pending[pending_count++] = Optimizer_get_target(optimizer, index);
+
+        uint8_t opcode = Optimizer_get_opcode(optimizer, index);
+        if (opcode != OpCode_Jump && opcode != OpCode_Loop && opcode != OpCode_Return)
+            pending[pending_count++] = Optimizer_next(optimizer, index + 1);
+    }
+
+    bool is_changed = false;
+    for (int i = 0; i < optimizer->count; i++) {
+        if (optimizer->items[i].is_removed || is_reachable[i]) continue;
+
+        Optimizer_remove(optimizer, i);
+        is_changed = true;
+    }
+
+    free(is_reachable);
+    free(pending);
+    return is_changed;
+}
+
+// Writes the instructions that are left back into 'bytecode', in place.
+//
+static void Optimizer_encode(Optimizer* optimizer) {
+    Bytecode* bytecode = optimizer->bytecode;
+
+    // .Offsets
+    //
+    // NOTE: A removed instruction takes the offset of the next one left,
+    //       so the jumps that landed on it land there.
+    //
+    int* new_offsets = (int*)malloc(sizeof(int) * (optimizer->count + 1));
+    assert(new_offsets);
+
+    int new_offset = 0;
+    for (int i = 0; i < optimizer->count; i++) {
+        new_offsets[i] = new_offset;
+        if (!optimizer->items[i].is_removed) new_offset += optimizer->items[i].size;
+    }
+    new_offsets[optimizer->count] = new_offset;
+
+    // .Instructions and Lines
+    //
+    // NOTE: Instructions only move towards the start, so copying them
+    //       forward never overwrites one that wasn't copied yet.
+    //
+    for (int i = 0; i < optimizer->count; i++) {
+        OptimizerInstruction* instruction = &optimizer->items[i];
+        if (instruction->is_removed) continue;
+
+        memmove(
+            bytecode->instructions.items + new_offsets[i],
+            bytecode->instructions.items + instruction->offset,
+            instruction->size
+        );
+        memmove(
+            bytecode->lines.items + new_offsets[i],
+            bytecode->lines.items + instruction->offset,
+            sizeof(int) * instruction->size
+        );
+
+        if (instruction->target == -1) continue;
+
+        uint8_t* bytes = bytecode->instructions.items + new_offsets[i];
+        int next_offset = new_offsets[i] + 3;
+        int target_offset = new_offsets[instruction->target];
+        int jump_distance = bytes[0] == OpCode_Loop
+            ? next_offset - target_offset
+            : target_offset - next_offset;
+
+        assert(jump_distance >= 0);
+        bool is_written = Bytecode_write_jump_distance(bytecode, new_offsets[i], jump_distance);
+        assert(is_written && "Error: Too many long jumps.");
+    }
+    bytecode->instructions.count = new_offset;
+    bytecode->lines.count        = new_offset;
+
+    // .Source Code
+    //
+    for (size_t i = 0; i < bytecode->source_code.count; i++) {
+        SourceCode* source_code = &bytecode->source_code.items[i];
+        int item_index = optimizer->index_of_offset[source_code->instruction_start_offset];
+
+        source_code->instruction_start_offset = new_offsets[item_index];
+    }
+
+    free(new_offsets);
+}
+
+void Bytecode_optimize(Bytecode* bytecode) {
+    if (bytecode->instructions.count == 0) return;
+
+    Optimizer optimizer;
+    Optimizer_decode(&optimizer, bytecode);
+
+    bool is_changed = true;
+    while (is_changed) {
+        is_changed = false;
+        for (int i = 0; i < optimizer.count; i++) {
+            if (optimizer.items[i].is_removed) continue;
+
+            if (Optimizer_rewrite_jump(&optimizer, i))               { is_changed = true; continue; }
+            if (Optimizer_rewrite_push_pop(&optimizer, i))           { is_changed = true; continue; }
+            if (Optimizer_rewrite_store_pop_load(&optimizer, i))     { is_changed = true; continue; }
+            if (Optimizer_rewrite_not_jump(&optimizer, i))           { is_changed = true; continue; }
+            if (Optimizer_rewrite_constant_condition(&optimizer, i)) { is_changed = true; continue; }
+            if (Optimizer_rewrite_push_jump_pop(&optimizer, i))      { is_changed = true; continue; }
+        }
+
+        if (Optimizer_remove_unreachable(&optimizer)) is_changed = true;
+    }
+
+    Optimizer_encode(&optimizer);
+    free(optimizer.items);
+    free(optimizer.index_of_offset);
+}
@@ -11,51 +11,169 @@
 //
 // HashTable core:
 //     Hash functions, Dynamic Resizing, and Collision Resolution,
+//
+// Layout (Swiss Table):
+//     The table is split in 3 parallel arrays of 'capacity' slots:
+//
+//     controls: 1 byte per slot, 'Control_Empty', 'Control_Deleted' or,
+//               for a used slot, the low 7 bits of the key's hash (H2).
+//     keys:     ObjectString* per slot.
+//     values:   Value per slot.
+//
+//     Slots are probed in Groups of 16. The high bits of the hash (H1)
+//     pick the first Group, and the 16 control bytes of a Group are
+//     compared against H2 with a single SSE2 instruction. Only the slots
+//     whose control byte matches are checked against the key, so most
+//     probes never touch the keys array. A lookup stops at the first
+//     Group with an empty slot.
+//
+//     'capacity' is always a power of two (and a multiple of the Group
+//     size), so picking a Group is a mask instead of a '%'.
+//
+// Tombstones:
+//     A deleted key leaves a tombstone ('Control_Deleted') behind, unless its
+//     Group still has an empty slot, in which case no probe sequence goes
+//     past that Group and the slot can go back to Empty. Tombstones are
+//     counted apart from the keys ('tombstones' vs 'count'). When they fill
+//     the table, the table is rehashed in place (same capacity, no
+//     allocation), and when the keys fall below 1/8 of the slots, the
+//     table shrinks.
+//
+// Small Tables:
+//     Most instance fields and class methods tables only hold a handful of
+//     keys. Up to 'HASH_TABLE_SMALL_CAPACITY_MAX' keys, a table has no
+//     controls array ('controls == NULL'): keys and values are packed at the
+//     front of their arrays and a lookup is a linear scan comparing the
+//     (interned) key pointers, no hashing involved. The table is promoted to
+//     the hashed layout when it outgrows that, and demoted back when it
+//     shrinks.
 
 #include "kriolu.h"
 
-// This guarantees that there'll always be an empty entry
-// in the entries array, which prevents inifinite loop
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASH_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+// This guarantees that there'll always be an empty slot
+// in the controls array, which prevents inifinite loop
 // when probing/search for a specific entry.
 //
-#define TABLE_MAX_LOAD 0.75
+#define TABLE_MAX_LOAD_NUMERATOR   7
+#define TABLE_MAX_LOAD_DENOMINATOR 8
+
+#define HASH_TABLE_GROUP_WIDTH     16
+#define HASH_TABLE_CAPACITY_MIN    16
+
+#define HASH_TABLE_SMALL_CAPACITY_MIN 4
+#define HASH_TABLE_SMALL_CAPACITY_MAX 8
+
+#define HashTable_Control_Empty    ((int8_t)-128) // 0b10000000
+#define HashTable_Control_Deleted  ((int8_t)-2)   // 0b11111110
+
+static int      hash_table_find_index(HashTable* table, ObjectString* key);
+static int      hash_table_find_insert_index(HashTable* table, ObjectString* key, bool* is_new_key);
+static int      hash_table_find_first_free_index(HashTable* table, uint32_t hash);
+static int      hash_table_capacity_for(int count);
+static void     hash_table_adjust_capacity(HashTable* table, int new_capacity);
+static void     hash_table_rehash_in_place(HashTable* table);
+static void     hash_table_shrink_if_sparse(HashTable* table);
+static void     hash_table_erase_index(HashTable* table, int index);
+static int      hash_table_small_find_index(HashTable* table, ObjectString* key);
+static void     hash_table_small_erase_index(HashTable* table, int index);
+static void     hash_table_small_resize(HashTable* table, int new_capacity);
+static uint32_t hash_table_group_match(const int8_t* group, int8_t control);
+static uint32_t hash_table_group_match_empty_or_deleted(const int8_t* group);
+
+static inline uint32_t hash_table_h1(uint32_t hash) { return hash >> 7; }
+static inline int8_t   hash_table_h2(uint32_t hash) { return (int8_t)(hash & 0x7F); }
+
+static inline int hash_table_count_trailing_zeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static inline bool hash_table_is_small(HashTable* table) {
+    return table->controls == NULL;
+}
 
-static Entry* hash_table_find_entry_by_key(Entry* entries, ObjectString* key, int capacity);
-static Entry* hash_table_probing(Entry* entries, ObjectString* key, int capacity);
-static void   hash_table_adjust_capacity(HashTable* table, int new_capacity);
-static Entry  hash_table_make_tombstone();
-static Entry  hash_table_make_empty_entry();
-static bool   hash_table_is_an_empty_entry(Entry* entry);
-static bool   hash_table_is_a_tombstone_entry(Entry* entry);
+static inline size_t hash_table_allocation_size(int capacity, bool is_small) {
+    size_t control_size = is_small ? 0 : sizeof(int8_t);
+    return (size_t)capacity * (sizeof(Value) + sizeof(ObjectString*) + control_size);
+}
 
 void hash_table_init(HashTable* table) {
-    table->items  = NULL;
-    table->count    = 0;
-    table->capacity = 0;
+    table->controls   = NULL;
+    table->keys       = NULL;
+    table->values     = NULL;
+    table->count      = 0;
+    table->tombstones = 0;
+    table->capacity   = 0;
 }
 
 void hash_table_copy(HashTable* from, HashTable* to) {
     for (int i = 0; i < from->capacity; i++) {
-        Entry* entry = &from->items[i];
-        if (entry->key != NULL) {
-            hash_table_set_value(to, entry->key, entry->value);
+        ObjectString* key = from->keys[i];
+        if (key != NULL) {
+            hash_table_set_value(to, key, from->values[i]);
         }
     }
 }
 
 bool hash_table_set_value(HashTable* table, ObjectString* key, Value value) {
-    if (table->count + 1 > table->capacity * TABLE_MAX_LOAD) {
-        int capacity = table->capacity < 8 ? 8 : 2 * table->capacity;
-        hash_table_adjust_capacity(table, capacity);
+    if (hash_table_is_small(table)) {
+        int index = hash_table_small_find_index(table, key);
+        if (index >= 0) {
+            table->values[index] = value;
+            return false;
+        }
+
+        if (table->count == table->capacity && table->capacity < HASH_TABLE_SMALL_CAPACITY_MAX) {
+            int capacity = table->capacity == 0 ? HASH_TABLE_SMALL_CAPACITY_MIN : 2 * table->capacity;
+            hash_table_small_resize(table, capacity);
+        }
+
+        if (table->count < table->capacity) {
+            table->keys[table->count]   = key;
+            table->values[table->count] = value;
+            table->count += 1;
+            return true;
+        }
+
+        // .Promote to the hashed layout
+        hash_table_adjust_capacity(table, HASH_TABLE_CAPACITY_MIN);
     }
 
-    Entry* entry = hash_table_find_entry_by_key(table->items, key, table->capacity);
-    bool is_new_key = (entry->key == NULL);
-    if (hash_table_is_an_empty_entry(entry))
-        table->count += 1;
+    int used = table->count + table->tombstones;
+    if ((used + 1) * TABLE_MAX_LOAD_DENOMINATOR > table->capacity * TABLE_MAX_LOAD_NUMERATOR) {
+        // NOTE: If the keys alone fit the current capacity at half the
+        //       maximum load, the table is mostly tombstones: clean them up
+        //       instead of growing.
+        //
+        int capacity = hash_table_capacity_for(table->count + 1);
+        if (table->tombstones > 0 && capacity <= table->capacity)
+            hash_table_rehash_in_place(table);
+        else
+            hash_table_adjust_capacity(table, capacity > 2 * table->capacity ? capacity : 2 * table->capacity);
+    }
+
+    bool is_new_key = false;
+    int index = hash_table_find_insert_index(table, key, &is_new_key);
+    if (is_new_key) {
+        if (table->controls[index] == HashTable_Control_Deleted)
+            table->tombstones -= 1;
+
+        table->controls[index] = hash_table_h2(key->hash);
+        table->keys[index]     = key;
+        table->count          += 1;
+    }
 
-    entry->key = key;
-    entry->value = value;
+    table->values[index] = value;
 
     return is_new_key;
 }
@@ -64,11 +182,12 @@ bool hash_table_get_value(HashTable* table, ObjectString* key, Value* value_out)
     if (table->count == 0)
         return false;
 
-    Entry* entry = hash_table_find_entry_by_key(table->items, key, table->capacity);
-    if (entry == NULL)      return false;
-    if (entry->key == NULL) return false;
+    int index = hash_table_is_small(table) ?
+        hash_table_small_find_index(table, key) :
+        hash_table_find_index(table, key);
+    if (index < 0) return false;
 
-    *value_out = entry->value;
+    *value_out = table->values[index];
     return true;
 }
 
@@ -76,22 +195,49 @@ ObjectString* hash_table_get_key(HashTable* table, String string, uint32_t hash)
     if (table->count == 0)
         return NULL;
 
-    uint32_t index = hash % table->capacity;
-    for (;;) {
-        Entry* entry = &table->items[index];
-        if (hash_table_is_an_empty_entry(entry))
-            return NULL;
+    if (hash_table_is_small(table)) {
+        for (int i = 0; i < table->count; i++) {
+            ObjectString* key = table->keys[i];
+            if (
+                key->hash == hash            &&
+                key->length == string.length &&
+                memcmp(key->characters, string.characters, string.length) == 0
+            ) {
+                return key;
+            }
+        }
 
-        if (
-            entry->key != NULL                  &&
-            entry->key->length == string.length &&
-            entry->key->hash == hash            &&
-            memcmp(entry->key->characters, string.characters, entry->key->length) == 0
-        ) {
-            return entry->key;
+        return NULL;
+    }
+
+    uint32_t group_mask = (uint32_t)(table->capacity / HASH_TABLE_GROUP_WIDTH) - 1;
+    uint32_t group      = hash_table_h1(hash) & group_mask;
+    int8_t   h2         = hash_table_h2(hash);
+
+    for (uint32_t step = 1;; step++) {
+        int group_start       = (int)group * HASH_TABLE_GROUP_WIDTH;
+        const int8_t* controls = table->controls + group_start;
+
+        uint32_t mask = hash_table_group_match(controls, h2);
+        while (mask != 0) {
+            ObjectString* key = table->keys[group_start + hash_table_count_trailing_zeros(mask)];
+            if (
+                key->hash == hash            &&
+                key->length == string.length &&
+                memcmp(key->characters, string.characters, string.length) == 0
+            ) {
+                return key;
+            }
+
+            mask &= mask - 1;
         }
 
-        index = (index + 1) % table->capacity;
+        if (hash_table_group_match(controls, HashTable_Control_Empty) != 0)
+            return NULL;
+
+        // Triangular probing: visits every Group when the number of
+        // Groups is a power of two.
+        group = (group + step) & group_mask;
     }
 }
 
@@ -99,169 +245,386 @@ bool hash_table_delete(HashTable* table, ObjectString* key) {
     if (table->count == 0)
         return false;
 
-    Entry* entry = hash_table_find_entry_by_key(table->items, key, table->capacity);
+    if (hash_table_is_small(table)) {
+        int index = hash_table_small_find_index(table, key);
+        if (index < 0) return false;
 
-    if (hash_table_is_a_tombstone_entry(entry) ||
-        hash_table_is_an_empty_entry(entry))
-        return false;
+        hash_table_small_erase_index(table, index);
+        return true;
+    }
+
+    int index = hash_table_find_index(table, key);
+    if (index < 0) return false;
+
+    hash_table_erase_index(table, index);
+    hash_table_shrink_if_sparse(table);
 
-    *entry = hash_table_make_tombstone();
     return true;
 }
 
-void hash_table_free(HashTable* table) {
-    Memory_FreeArray(Entry, table->items, table->count);
-    hash_table_init(table);
-}
+// Deletes every Key/Value pair for which 'predicate' returns true.
+// Unlike calling 'hash_table_delete' while iterating the table, the table is
+// only resized (once) at the end, so the slots don't move under the loop.
+//
+// NOTE: The resize allocates. The Garbage Collector calls this while
+//       sweeping the strings database, see 'M_is_collecting' in memory.c.
+//
+int hash_table_delete_if(HashTable* table, HashTablePredicate* predicate) {
+    int deleted = 0;
+    if (hash_table_is_small(table)) {
+        // NOTE: erasing moves the last key into the erased slot, so the
+        //       same index is checked again.
+        //
+        for (int i = 0; i < table->count;) {
+            if (predicate(table->keys[i], table->values[i])) {
+                hash_table_small_erase_index(table, i);
+                deleted += 1;
+            } else {
+                i += 1;
+            }
+        }
 
-static Entry hash_table_make_empty_entry() {
-    Entry entry = { 0 };
-    entry.key = NULL;
-    entry.value = value_make_nil();
+        return deleted;
+    }
 
-    return entry;
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->keys[i] == NULL) continue;
+        if (!predicate(table->keys[i], table->values[i])) continue;
+
+        hash_table_erase_index(table, i);
+        deleted += 1;
+    }
+
+    if (deleted > 0)
+        hash_table_shrink_if_sparse(table);
+
+    return deleted;
 }
 
-static Entry hash_table_make_tombstone()
-{
-    Entry tombstone;
-    tombstone.key = NULL;
-    tombstone.value = value_make_boolean(true);
+// Diagnostics: probe length is the number of Groups visited to find a key,
+// 1 means the key is in the first Group of its probe sequence. A small table
+// is a single linear scan, so every key reports 1.
+//
+void hash_table_get_statistics(HashTable* table, HashTableStatistics* statistics) {
+    statistics->count              = table->count;
+    statistics->tombstones         = table->tombstones;
+    statistics->capacity           = table->capacity;
+    statistics->load_factor        = table->capacity > 0 ? (double)(table->count + table->tombstones) / table->capacity : 0.0;
+    statistics->probe_length_total = 0;
+    statistics->probe_length_max   = 0;
+
+    if (table->capacity == 0) return;
+    if (hash_table_is_small(table)) {
+        statistics->probe_length_total = table->count;
+        statistics->probe_length_max   = table->count > 0 ? 1 : 0;
+        return;
+    }
 
-    return tombstone;
+    uint32_t group_mask = (uint32_t)(table->capacity / HASH_TABLE_GROUP_WIDTH) - 1;
+    for (int i = 0; i < table->capacity; i++) {
+        ObjectString* key = table->keys[i];
+        if (key == NULL) continue;
+
+        uint32_t group_target = (uint32_t)(i / HASH_TABLE_GROUP_WIDTH);
+        uint32_t group        = hash_table_h1(key->hash) & group_mask;
+        int probe_length      = 1;
+        for (uint32_t step = 1; group != group_target; step++) {
+            group = (group + step) & group_mask;
+            probe_length += 1;
+        }
+
+        statistics->probe_length_total += probe_length;
+        if (probe_length > statistics->probe_length_max)
+            statistics->probe_length_max = probe_length;
+    }
+}
+
+void hash_table_free(HashTable* table) {
+    Memory_allocate(table->values, hash_table_allocation_size(table->capacity, hash_table_is_small(table)), 0);
+    hash_table_init(table);
 }
 
-static bool hash_table_is_an_empty_entry(Entry* entry)
-{
-    return (entry->key == NULL && value_is_nil(entry->value));
+// Returns a bit mask with the bit 'i' set when 'group[i] == control'.
+//
+static uint32_t hash_table_group_match(const int8_t* group, int8_t control) {
+#ifdef HASH_TABLE_SSE2
+    __m128i controls = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(control)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < HASH_TABLE_GROUP_WIDTH; i++) {
+        if (group[i] == control) mask |= (1u << i);
+    }
+    return mask;
+#endif
 }
 
-static bool hash_table_is_a_tombstone_entry(Entry* entry) {
-    return (
-        entry->key == NULL &&
-        value_is_boolean(entry->value) &&
-        value_as_boolean(entry->value) == true);
+// Empty and Deleted are the only control bytes with the sign bit set.
+//
+static uint32_t hash_table_group_match_empty_or_deleted(const int8_t* group) {
+#ifdef HASH_TABLE_SSE2
+    __m128i controls = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(controls);
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < HASH_TABLE_GROUP_WIDTH; i++) {
+        if (group[i] < 0) mask |= (1u << i);
+    }
+    return mask;
+#endif
 }
 
-static bool hash_table_is_hash_collision(ObjectString* a, ObjectString* b) {
-    return (
-        a->length == b->length &&
-        a->hash == b->hash     &&
-        memcmp(a->characters, b->characters, a->length) != 0
-    );
+// Return: index of the key's slot | -1
+//
+static int hash_table_find_index(HashTable* table, ObjectString* key) {
+    uint32_t group_mask = (uint32_t)(table->capacity / HASH_TABLE_GROUP_WIDTH) - 1;
+    uint32_t group      = hash_table_h1(key->hash) & group_mask;
+    int8_t   h2         = hash_table_h2(key->hash);
+
+    for (uint32_t step = 1;; step++) {
+        int group_start        = (int)group * HASH_TABLE_GROUP_WIDTH;
+        const int8_t* controls = table->controls + group_start;
+
+        // This is possible because string deduplication is implemented, otherwise
+        // key characters must be equal.
+        //
+        uint32_t mask = hash_table_group_match(controls, h2);
+        while (mask != 0) {
+            int index = group_start + hash_table_count_trailing_zeros(mask);
+            if (table->keys[index] == key)
+                return index;
+
+            mask &= mask - 1;
+        }
+
+        if (hash_table_group_match(controls, HashTable_Control_Empty) != 0)
+            return -1;
+
+        group = (group + step) & group_mask;
+    }
 }
 
-static bool hash_table_is_key_collision(Entry* entry, ObjectString* key) {
-    if (entry->key->length != key->length) return true;
-    if (entry->key->hash != key->hash) return true;
-    if (memcmp(entry->key->characters, key->characters, entry->key->length) != 0) return true;
+// Return: index of the key's slot (is_new_key = false) |
+//         index of the first Empty/Deleted slot in the probe sequence (is_new_key = true)
+//
+static int hash_table_find_insert_index(HashTable* table, ObjectString* key, bool* is_new_key) {
+    uint32_t group_mask = (uint32_t)(table->capacity / HASH_TABLE_GROUP_WIDTH) - 1;
+    uint32_t group      = hash_table_h1(key->hash) & group_mask;
+    int8_t   h2         = hash_table_h2(key->hash);
+    int      free_index = -1;
+
+    for (uint32_t step = 1;; step++) {
+        int group_start        = (int)group * HASH_TABLE_GROUP_WIDTH;
+        const int8_t* controls = table->controls + group_start;
+
+        uint32_t mask = hash_table_group_match(controls, h2);
+        while (mask != 0) {
+            int index = group_start + hash_table_count_trailing_zeros(mask);
+            if (table->keys[index] == key) {
+                *is_new_key = false;
+                return index;
+            }
+
+            mask &= mask - 1;
+        }
 
-    // The keys are the same
-    return false;
+        // Keep the first tombstone/empty slot, but the key could still be
+        // further down the probe sequence, until a Group with an empty slot.
+        uint32_t free_mask = hash_table_group_match_empty_or_deleted(controls);
+        if (free_index < 0 && free_mask != 0)
+            free_index = group_start + hash_table_count_trailing_zeros(free_mask);
 
-    // return (
-    //     entry->key->length != key->length ||
-    //     entry->key->hash != key->hash ||
-    //     memcmp(entry->key->characters, key->characters, entry->key->length) != 0);
+        if (hash_table_group_match(controls, HashTable_Control_Empty) != 0) {
+            *is_new_key = true;
+            return free_index;
+        }
+
+        group = (group + step) & group_mask;
+    }
 }
 
-static Entry* hash_table_find_entry_by_key(Entry* entries, ObjectString* key, int capacity) {
-    uint32_t index = key->hash % capacity;
-    Entry* entry = &entries[index];
+static void hash_table_erase_index(HashTable* table, int index) {
+    // NOTE: If the slot's Group still has an empty slot, every probe sequence
+    //       that reaches this Group stops here, so the slot can be Empty again.
+    //       Otherwise it has to become a tombstone, because it might be in the
+    //       middle of another key's probe sequence.
+    //
+    const int8_t* group = table->controls + (index / HASH_TABLE_GROUP_WIDTH) * HASH_TABLE_GROUP_WIDTH;
+    if (hash_table_group_match(group, HashTable_Control_Empty) != 0) {
+        table->controls[index] = HashTable_Control_Empty;
+    } else {
+        table->controls[index] = HashTable_Control_Deleted;
+        table->tombstones     += 1;
+    }
 
-    if (entry->key == key)
-        return entry;
+    table->keys[index]   = NULL;
+    table->values[index] = value_make_nil();
+    table->count        -= 1;
+}
 
-    if (hash_table_is_a_tombstone_entry(entry))
-        return entry;
+// Smallest capacity that holds 'count' keys at no more than half the
+// maximum load, so the table doesn't resize again right away.
+//
+static int hash_table_capacity_for(int count) {
+    int capacity = HASH_TABLE_CAPACITY_MIN;
+    while (count * 2 * TABLE_MAX_LOAD_DENOMINATOR > capacity * TABLE_MAX_LOAD_NUMERATOR)
+        capacity *= 2;
 
-    if (hash_table_is_an_empty_entry(entry))
-        return entry;
+    return capacity;
+}
 
-    if (hash_table_is_key_collision(entry, key))
-        return hash_table_probing(entries, key, capacity);
+static void hash_table_shrink_if_sparse(HashTable* table) {
+    if (hash_table_is_small(table))           return;
+    if (table->count >= table->capacity / 8)  return;
 
-    // 'entry->key' is the same as the 'key'
-    // same hash, length, and characters
-    return entry;
+    if (table->count <= HASH_TABLE_SMALL_CAPACITY_MAX / 2)
+        hash_table_small_resize(table, HASH_TABLE_SMALL_CAPACITY_MAX);
+    else if (table->capacity > HASH_TABLE_CAPACITY_MIN)
+        hash_table_adjust_capacity(table, hash_table_capacity_for(table->count));
 }
 
-// Probing is a sequence of non-empty entries terminated by an empty entry.
-// We know we’ve reached the end of a sequence and that the
-// when we hit an empty bucket.
+static int hash_table_small_find_index(HashTable* table, ObjectString* key) {
+    for (int i = 0; i < table->count; i++) {
+        if (table->keys[i] == key) return i;
+    }
+
+    return -1;
+}
+
+// Keeps the keys packed: the last Key/Value pair takes the erased slot.
 //
-// Return: entry-found | entry-empty | entry-tombstone
+static void hash_table_small_erase_index(HashTable* table, int index) {
+    int last = table->count - 1;
+    table->keys[index]   = table->keys[last];
+    table->values[index] = table->values[last];
+    table->keys[last]    = NULL;
+    table->values[last]  = value_make_nil();
+    table->count        -= 1;
+}
+
+// Moves the keys of 'table' (small or hashed) into a new small table.
 //
-static Entry* hash_table_probing(Entry* entries, ObjectString* key, int capacity) {
-    uint32_t index = key->hash % capacity;
-    Entry* tombstone = NULL;
+static void hash_table_small_resize(HashTable* table, int new_capacity) {
+    assert(table->count <= new_capacity);
 
-    for (;;)
-    {
-        Entry* entry = &entries[index];
-        if (hash_table_is_an_empty_entry(entry))
-            return tombstone != NULL ? tombstone : entry;
+    char* block = (char*)Memory_allocate(NULL, 0, hash_table_allocation_size(new_capacity, true));
+    assert(block);
 
-        if (hash_table_is_a_tombstone_entry(entry))
-            tombstone = entry;
+    HashTable resized = { 0 };
+    resized.values   = (Value*)block;
+    resized.keys     = (ObjectString**)(block + sizeof(Value) * new_capacity);
+    resized.controls = NULL;
+    resized.capacity = new_capacity;
+    memset(resized.keys, 0, sizeof(ObjectString*) * new_capacity);
 
-        // This is possible because string deduplication is implemented, otherwise
-        // key characters must be equal.
-        //
-        if (entry->key == key)
-            return entry;
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->keys[i] == NULL) continue;
 
-        index = (index + 1) % capacity;
+        resized.keys[resized.count]   = table->keys[i];
+        resized.values[resized.count] = table->values[i];
+        resized.count += 1;
     }
+
+    hash_table_free(table);
+    *table = resized;
 }
 
-// static Entry* hash_table_find_entry(Entry* entries, ObjectString* key, int capacity)
-// {
-//     uint32_t index = key->hash % capacity;
-//     Entry* tombstone = NULL;
-//     for (;;)
-//     {
-//         Entry* entry = &entries[index];
-//         if (hash_table_is_an_empty_entry(entry))
-//             return tombstone != NULL ? tombstone : entry;
+static int hash_table_find_first_free_index(HashTable* table, uint32_t hash) {
+    uint32_t group_mask = (uint32_t)(table->capacity / HASH_TABLE_GROUP_WIDTH) - 1;
+    uint32_t group      = hash_table_h1(hash) & group_mask;
 
-//         if (entry->key == key)
-//             return entry;
+    for (uint32_t step = 1;; step++) {
+        int group_start = (int)group * HASH_TABLE_GROUP_WIDTH;
+        uint32_t mask   = hash_table_group_match_empty_or_deleted(table->controls + group_start);
+        if (mask != 0)
+            return group_start + hash_table_count_trailing_zeros(mask);
 
-//         if (hash_table_is_a_tombstone_entry(entry))
-//             tombstone = entry;
+        group = (group + step) & group_mask;
+    }
+}
 
-//         index = (index + 1) % capacity;
-//     }
-// }
+// Removes all the tombstones without allocating:
+//   1. Deleted slots become Empty and used slots become Deleted, 'Deleted'
+//      now means "key waiting to be placed".
+//   2. Every waiting key goes to the first free slot of its probe sequence:
+//      - same Group it's already in: it stays;
+//      - an Empty slot: it moves there;
+//      - another waiting key: they swap, and the other key is placed next.
+//
+static void hash_table_rehash_in_place(HashTable* table) {
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->controls[i] == HashTable_Control_Deleted) table->controls[i] = HashTable_Control_Empty;
+        else if (table->controls[i] >= 0)                    table->controls[i] = HashTable_Control_Deleted;
+    }
+
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->controls[i] != HashTable_Control_Deleted) continue;
+
+        ObjectString* key = table->keys[i];
+        int target = hash_table_find_first_free_index(table, key->hash);
+        if (target / HASH_TABLE_GROUP_WIDTH == i / HASH_TABLE_GROUP_WIDTH) {
+            table->controls[i] = hash_table_h2(key->hash);
+            continue;
+        }
+
+        if (table->controls[target] == HashTable_Control_Empty) {
+            table->controls[target] = hash_table_h2(key->hash);
+            table->keys[target]     = key;
+            table->values[target]   = table->values[i];
+            table->controls[i]      = HashTable_Control_Empty;
+            table->keys[i]          = NULL;
+            table->values[i]        = value_make_nil();
+            continue;
+        }
+
+        // .Swap with the waiting key in 'target' and place that one next.
+        ObjectString* key_target = table->keys[target];
+        Value value_target       = table->values[target];
+        table->controls[target]  = hash_table_h2(key->hash);
+        table->keys[target]      = key;
+        table->values[target]    = table->values[i];
+        table->keys[i]           = key_target;
+        table->values[i]         = value_target;
+        i -= 1;
+    }
+
+    table->tombstones = 0;
+}
 
 static void hash_table_adjust_capacity(HashTable* table, int new_capacity) {
-    // Allocate an empty array of Entry(Key/Value Pair)
+    // Allocate the 3 arrays in a single block: values | keys | controls.
+    // 'values' goes first so every array stays naturally aligned.
     //
-    Entry* entries = Memory_AllocateArray(Entry, NULL, table->capacity, new_capacity);
-    assert(entries);
-    for (int i = 0; i < new_capacity; i++) {
-        entries[i] = hash_table_make_empty_entry();
-    }
+    char* block = (char*)Memory_allocate(NULL, 0, hash_table_allocation_size(new_capacity, false));
+    assert(block);
+
+    HashTable resized = { 0 };
+    resized.values   = (Value*)block;
+    resized.keys     = (ObjectString**)(block + sizeof(Value) * new_capacity);
+    resized.controls = (int8_t*)(block + (sizeof(Value) + sizeof(ObjectString*)) * new_capacity);
+    resized.capacity   = new_capacity;
+    resized.count      = 0;
+    resized.tombstones = 0;
+    memset(resized.keys, 0, sizeof(ObjectString*) * new_capacity);
+    memset(resized.controls, HashTable_Control_Empty, new_capacity);
 
-    // Copy entry values from "table->entries" to the new allocated "entries" variable.
     // Since the hash-table capacity changed, the individual entry will
-    // be indexed in a different bucket, therefore the need to call
-    // hash_table_find_entry_by_key() to recalculate the new position.
+    // be indexed in a different slot, therefore the need to probe again
+    // for the new position. Tombstones are left behind.
     //
-    table->count = 0;
     for (int i = 0; i < table->capacity; i++) {
-        Entry* entry = &table->items[i];
-        if (entry->key == NULL)
+        ObjectString* key = table->keys[i];
+        if (key == NULL)
             continue;
 
-        Entry* dest = hash_table_find_entry_by_key(entries, entry->key, new_capacity);
-        dest->key     = entry->key;
-        dest->value   = entry->value;
-        table->count += 1;
+        bool is_new_key = false;
+        int index = hash_table_find_insert_index(&resized, key, &is_new_key);
+        resized.controls[index] = hash_table_h2(key->hash);
+        resized.keys[index]     = key;
+        resized.values[index]   = table->values[i];
+        resized.count += 1;
     }
 
-    Memory_FreeArray(Entry, table->items, table->capacity);
-    table->items  = entries;
-    table->capacity = new_capacity;
+    hash_table_free(table);
+    *table = resized;
 }
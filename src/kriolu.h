@@ -18,7 +18,13 @@
 // 
 
 #define DEBUG_LOG_PARSER
+// NOTE: A release build ('build.sh --release') doesn't trace the compiler,
+//       so stdout only has what the script prints.
+#ifdef KRIOLU_RELEASE
+#define DEBUG_TRACE_INSTRUCTION false
+#else
 #define DEBUG_TRACE_INSTRUCTION true    // TODO: rename 'DEBUG_VM_TRACE_INSTRUCTION true'
+#endif
 // #define DEBUG_GC_TRACE
 // #define DEBUG_GC_STRESS
 // #define DEBUG_TRACE_EXECUTION
@@ -158,6 +164,22 @@ uint32_t string_hash(String string);
 bool string_equal(String a, String b);
 void string_free(String* string);
 
+// String Kernels: byte-level search/compare primitives with scalar, SSE2
+// and AVX2 versions, the best one is picked at runtime by 'string_kernel_init'.
+//
+typedef struct {
+    const char* name;
+    int (*find)(const char* haystack, int haystack_length, const char* needle, int needle_length);
+    int (*count)(const char* haystack, int length, char byte);
+    int (*mismatch)(const char* a, const char* b, int length);
+} StringKernel;
+
+void string_kernel_init(void);
+StringKernel* string_kernel_get(void);
+int string_find(String haystack, String needle);
+int string_count(String haystack, String needle);
+int string_compare(String a, String b);
+
 //
 // Line Number
 //
@@ -178,6 +200,11 @@ void array_line_free(ArrayLineNumber* lines);
 // Instruction
 //
 
+// NOTE: The '_Long' variants of the locals and heap-values opcodes take a
+//       2 bytes index. The '_Long' jumps have the same size as the short
+//       ones, their operand is the index of a number in 'values' holding
+//       the distance, so a jump can grow when it's patched.
+//
 typedef uint8_t OpCode;
 enum {
     OpCode_Invalid,
@@ -190,9 +217,13 @@ enum {
     OpCode_Stack_Push_Closure,
     OpCode_Stack_Push_Closure_Long,
     OpCode_Stack_Copy_From_idx_To_Top,
+    OpCode_Stack_Copy_From_idx_To_Top_Long,
     OpCode_Stack_Copy_Top_To_Idx,
+    OpCode_Stack_Copy_Top_To_Idx_Long,
     OpCode_Stack_Copy_From_Heap_To_Top,
+    OpCode_Stack_Copy_From_Heap_To_Top_Long,
     OpCode_Stack_Move_Top_To_Heap, 
+    OpCode_Stack_Move_Top_To_Heap_Long,
     OpCode_Stack_Move_Value_To_Heap,
     OpCode_Stack_Pop,
     OpCode_Interpolation,
@@ -210,16 +241,24 @@ enum {
 
     OpCode_Print,
     OpCode_Jump_If_False,
+    OpCode_Jump_If_False_Long,
+    OpCode_Jump_If_True,
+    OpCode_Jump_If_True_Long,
     OpCode_Jump,
+    OpCode_Jump_Long,
     OpCode_Define_Global,
     OpCode_Read_Global,
     OpCode_Assign_Global,
 
     OpCode_Loop,
+    OpCode_Loop_Long,
     OpCode_Call_Function,
+    OpCode_Call_Function_Tail,  // NOTE: 'divolvi f(...)', reuses the caller's FunctionCall when 'f' is a Closure
     OpCode_Call_Method,
+    OpCode_Call_Method_Tail,        // NOTE: 'divolvi o.f(...)', see 'OpCode_Call_Function_Tail'
     OpCode_Call_Class,
     OpCode_Call_Super_Method,
+    OpCode_Call_Super_Method_Tail,  // NOTE: 'divolvi Super.f(...)', see 'OpCode_Call_Function_Tail'
     OpCode_Call_Closure,
     OpCode_Class,
     OpCode_Method,
@@ -341,32 +380,56 @@ typedef struct {
     SourceCode *items; 
 } ArraySourceCode;
 
+// Compile-time lookup from a constant to its index in 'values', so each
+// distinct constant is stored once per function. Numbers are keyed by their
+// bits and objects by their address (strings are interned). A slot holds the
+// value index + 1, 0 marks an empty slot.
+//
+typedef struct {
+    int* slots;
+    int count;
+    int capacity;
+} ConstantIndex;
+
 typedef struct {
     ArrayInstruction instructions;
     ArrayValue       values;
     ArrayLineNumber  lines;
     ArraySourceCode  source_code;
+    ConstantIndex    constants; // NOTE: Released by 'Bytecode_free_constants' once the function is compiled
 } Bytecode;
 
 #define Compiler_CompileInstruction_1Byte(bytecode, opcode, line) Bytecode_insert_instruction_1byte(bytecode, opcode, line, DEBUG_TRACE_INSTRUCTION)
 #define Compiler_CompileInstruction_2Bytes(bytecode, opcode, operand, line) Bytecode_insert_instruction_2bytes(bytecode, opcode, operand, line, DEBUG_TRACE_INSTRUCTION)
 #define Compiler_CompileInstruction_3Bytes(bytecode, opcode, op1, op2, line) Bytecode_insert_instruction_3bytes(bytecode, opcode, op1, op2, line, DEBUG_TRACE_INSTRUCTION)
+#define Compiler_CompileInstruction_Index(bytecode, opcode, index, line) Bytecode_insert_instruction_index(bytecode, opcode, index, line, DEBUG_TRACE_INSTRUCTION)
 #define Compiler_CompileInstruction_Constant(bytecode, value, line) Bytecode_insert_instruction_constant(bytecode, value, line, DEBUG_TRACE_INSTRUCTION)
 #define Compiler_CompileInstruction_Closure(bytecode, value, outsiders, line) Bytecode_insert_instruction_closure(bytecode, value, outsiders, line, DEBUG_TRACE_INSTRUCTION)
 #define Compiler_CompileInstruction_Jump(bytecode, opcode, line) Bytecode_insert_instruction_jump(bytecode, opcode, line, DEBUG_TRACE_INSTRUCTION)
 #define Compiler_CompileInstruction_Loop(bytecode, start_index, line) Bytecode_emit_instruction_loop(bytecode, start_index, line, DEBUG_TRACE_INSTRUCTION)
-#define Compiler_CompileValue(bytecode, value) ArrayValue_insert(&bytecode->values, value)
+#define Compiler_CompileValue(bytecode, value) Bytecode_insert_value(bytecode, value)
 #define Compiler_PatchInstructionJump(bytecode, operand_index) Bytecode_patch_instruction_jump(bytecode, operand_index, DEBUG_TRACE_INSTRUCTION)
 
 void Bytecode_init(Bytecode* bytecode);
 int  Bytecode_insert_instruction_1byte(Bytecode* bytecode, OpCode opcode, int line_number, bool debug_trace_on);
 int  Bytecode_insert_instruction_2bytes(Bytecode* bytecode, OpCode opcode, uint8_t operand, int line_number, bool debug_trace_on);
 int  Bytecode_insert_instruction_3bytes(Bytecode* bytecode, OpCode opcode, uint8_t operand_1, uint8_t operand_2, int line_number, bool debug_trace_on);
+int  Bytecode_insert_instruction_index(Bytecode* bytecode, OpCode opcode, int index, int line_number, bool debug_trace_on);
 int  Bytecode_insert_instruction_constant(Bytecode* bytecode, Value value, int line_number, bool debug_trace_on);
 void Bytecode_insert_instruction_closure(Bytecode* bytecode, Value value, ArrayOutsider* outsiders, int line_number, bool debug_trace_on);
 int  Bytecode_insert_instruction_jump(Bytecode* bytecode, OpCode opcode, int line, bool debug_trace_on);
-void Bytecode_emit_instruction_loop(Bytecode* bytecode, int jump_to_index, int line_number, bool debug_trace_on);
+bool Bytecode_emit_instruction_loop(Bytecode* bytecode, int jump_to_index, int line_number, bool debug_trace_on);
 bool Bytecode_patch_instruction_jump(Bytecode* bytecode, int operand_index, bool debug_trace_on);
+int  Bytecode_read_jump_distance(Bytecode* bytecode, int offset);
+bool Bytecode_write_jump_distance(Bytecode* bytecode, int offset, int distance);
+OpCode Bytecode_get_jump_short_form(OpCode opcode);
+int  Bytecode_read_constant(Bytecode* bytecode, int offset, Value* value_out);
+int  Bytecode_insert_value(Bytecode* bytecode, Value value);
+void Bytecode_free_constants(Bytecode* bytecode);
+void Bytecode_truncate(Bytecode* bytecode, int instruction_count, int value_count);
+int  Bytecode_get_instruction_size(Bytecode* bytecode, int offset);
+int  Bytecode_get_max_stack_depth(Bytecode* bytecode, int depth_start);
+void Bytecode_optimize(Bytecode* bytecode);
 void Bytecode_disassemble_header(char* title_name);
 void Bytecode_disassemble(Bytecode* bytecode, const char* name);
 int  Bytecode_disassemble_instruction(Bytecode* bytecode, int offset);
@@ -388,26 +451,41 @@ void Bytecode_debug_print(const char* format, ...);
 //  HashTable
 // key  | Value
 // ---------------
-// 1248   "Hello"  -> Entry  <- *entries
+// 1248   "Hello"  -> Entry
 // 4323    9892    -> Entry
 //
-// Entries: [{1248, "Hello"}, {4323, 9892}, ...]
-//           ---------------  ------------
-//                Entry           Entry
+// The Entries are stored as parallel arrays (Swiss Table), plus 1 control
+// byte per slot with 7 bits of the key's hash:
+//
+// controls: [ 0x1A,  0x80(empty), 0x33, ...]
+// keys:     [ 1248,  NULL,        4323, ...]
+// values:   ["Hello", nulo,       9892, ...]
+//
+// An unused slot has 'keys[i] == NULL', so iterating a table is:
+//     for (int i = 0; i < table->capacity; i++) if (table->keys[i] != NULL) ...
 
 typedef struct HashTable HashTable;
 typedef struct ObjectString ObjectString;
 
-typedef struct {
-    ObjectString* key;
-    Value value;
-} Entry;
-
 struct HashTable {
-    Entry* items;
+    int8_t* controls;
+    ObjectString** keys;
+    Value* values;
+    int count;      // keys in the table
+    int tombstones; // deleted slots not yet reclaimed
+    int capacity;   // power of two
+};
+
+typedef bool HashTablePredicate(ObjectString* key, Value value);
+
+typedef struct {
     int count;
+    int tombstones;
     int capacity;
-};
+    double load_factor;
+    long long probe_length_total;
+    int probe_length_max;
+} HashTableStatistics;
 
 void hash_table_init(HashTable* table);
 void hash_table_copy(HashTable* from, HashTable* to); // tableAddAll
@@ -415,6 +493,8 @@ bool hash_table_set_value(HashTable* table, ObjectString* key, Value value);
 bool hash_table_get_value(HashTable* table, ObjectString* key, Value* value_out);
 ObjectString* hash_table_get_key(HashTable* table, String string, uint32_t hash);
 bool hash_table_delete(HashTable* table, ObjectString* key);
+int  hash_table_delete_if(HashTable* table, HashTablePredicate* predicate);
+void hash_table_get_statistics(HashTable* table, HashTableStatistics* statistics);
 void hash_table_free(HashTable* table);
 
 //
@@ -449,6 +529,7 @@ static const char* ObjectKind_text[] = {
 struct Object {
     ObjectKind  kind;
     bool        is_marked;
+    bool        is_permanent;   // NOTE: Moved to 'objects_permanent', see 'Memory_end_compilation'
     Object     *next;
 };
 
@@ -463,13 +544,18 @@ struct ObjectString {
     uint32_t hash;
 };
 
+typedef struct ObjectClosure ObjectClosure;
+
 typedef struct {
     Object object;
 
     Bytecode bytecode;
     ObjectString* name;
-    int arity;              // Number of parameters
-    int outsiders_count;    // old_value: variable_dependencies_count;
+    int arity;                      // Number of parameters
+    int outsiders_count;            // old_value: variable_dependencies_count;
+    int max_stack_depth;            // NOTE: Slots used from 'frame_start', parameters included
+    bool has_captured_locals;       // NOTE: Some local is captured by a closure, 'Return' has to move it to the heap
+    ObjectClosure* closure_shared;  // NOTE: With no outsiders every closure is the same, made once
 } ObjectFunction;
 
 typedef Value FunctionNative(VirtualMachine* vm, int argument_count, Value* arguments);
@@ -486,20 +572,18 @@ struct ObjectValue {
 
     Value* value_address; 
     Value value;
-    ObjectValue* next;
 };
 
-typedef struct {
-    ObjectValue** items;
-    int count;
-} ArrayObjectValue;
-
-typedef struct {
+// NOTE: The 'heap_values' are allocated along with the closure, one per
+//       outsider of its function.
+//
+struct ObjectClosure {
     Object object;
 
     ObjectFunction* function;
-    ArrayObjectValue heap_values;
-} ObjectClosure;
+    int heap_values_count;
+    ObjectValue* heap_values[];
+};
 
 typedef struct {
     Object object;
@@ -507,10 +591,14 @@ typedef struct {
     HashTable methods;
 } ObjectClass;
 
+// NOTE: 'methods_bound' caches, by method name, the ObjectMethod made the
+//       last time a method was read from the Instance without being called.
+//
 typedef struct {
     Object object;
     ObjectClass *klass;
     HashTable fields;
+    HashTable methods_bound;
 } ObjectInstance;
 
 typedef struct {
@@ -555,6 +643,39 @@ ObjectClass* ObjectClass_alocate(ObjectString* name, Object** object_head);
 ObjectInstance* ObjectInstance_allocate(ObjectClass *klass, Object** object_head);
 ObjectMethod* ObjectMethod_allocate(Value instance, ObjectClosure* method, Object** object_head);
 
+//
+// Arena
+//
+// Bump allocator for the data that lives as long as the Parser: the AST
+// nodes, the 'Function' records and the 'ClassDeclaration's. Released in
+// one shot with 'Arena_free'. Not tracked by the Garbage Collector.
+//
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT  8
+
+typedef struct ArenaBlock ArenaBlock;
+struct ArenaBlock {
+    LinkedList(ArenaBlock) next;
+    size_t capacity;
+    size_t used;
+    char data[];
+};
+
+typedef struct {
+    LinkedList(ArenaBlock) blocks; // NOTE: The current block is the first one
+    size_t bytes_used;
+    size_t bytes_reserved;
+} Arena;
+
+#define Arena_Allocate(arena, type) \
+    (type*) Arena_allocate((arena), sizeof(type))
+
+void  Arena_init(Arena* arena);
+void* Arena_allocate(Arena* arena, size_t size);
+void* Arena_reallocate(Arena* arena, void* pointer, size_t old_size, size_t new_size);
+void  Arena_free(Arena* arena);
+
 //
 // Abstract Syntax Tree
 //
@@ -714,8 +835,15 @@ void array_statement_free(ArrayStatement* statements);
 //
 
 #define UINT8_COUNT (UINT8_MAX + 1)
+#define UINT16_COUNT (UINT16_MAX + 1)
 #define INITIALIZED -1
 
+// NOTE: Past 256 the locals and the outsiders are read with the '_Long'
+//       opcodes, which take a 2 bytes index.
+//
+#define LOCALS_MAX    UINT16_COUNT
+#define OUTSIDERS_MAX UINT16_COUNT
+
 typedef enum {
     LocalAction_Default,
     LocalAction_Move_Heap
@@ -728,12 +856,13 @@ typedef struct {
 } Local;
 
 typedef struct {
-    Local items[UINT8_COUNT];
+    Local* items;       // NOTE: Grows in 'arena' and is kept when the Function is reused
     int top;
     int capacity;
+    Arena* arena;
 } StackLocal;
 
-void   StackLocal_init(StackLocal* locals);
+void   StackLocal_init(StackLocal* locals, Arena* arena);
 Local  StackLocal_push(StackLocal* locals, Local new_local);
 Local  StackLocal_pop(StackLocal* locals);
 Local* StackLocal_peek(StackLocal* locals, int offset);
@@ -758,18 +887,25 @@ typedef enum {
     LocalLocation_In_Parent_Stack
 } LocalLocation;
 
+// NOTE: Set on the location byte of a closure's outsider when its index
+//       takes 2 bytes.
+//
+#define LOCAL_LOCATION_INDEX_LONG 0x80
+
 typedef struct {
-    uint8_t index;
+    uint16_t index;
     LocalLocation location;
 } Outsider;
     
 struct ArrayOutsider {
-    Outsider items[UINT8_COUNT];
+    Outsider* items;    // NOTE: Grows in 'arena', like 'StackLocal'
     int count;
+    int capacity;
+    Arena* arena;
 };
 
-void ArrayOutsider_init(ArrayOutsider* local_metadata, int count);
-int  ArrayOutsider_add(ArrayOutsider* local_metadata, uint8_t index, LocalLocation location, int* variable_dependencies_count);
+void ArrayOutsider_init(ArrayOutsider* local_metadata, int count, Arena* arena);
+int  ArrayOutsider_add(ArrayOutsider* local_metadata, int index, LocalLocation location, int* variable_dependencies_count);
 
 typedef struct Function Function;
 struct Function {
@@ -781,6 +917,8 @@ struct Function {
     ArrayOutsider outsiders;        // old_value: 'variable_dependencies' | NOTE: Varibale accessed that belongs to a parent function
     Token class_name;
     int depth;                      // NOTE: Scope depth
+    int call_offset_last;           // NOTE: Offset of the last function or method call emitted, -1 if none
+    int property_get_offset_last;   // NOTE: Offset of the last 'OpCode_Object_Get_Property' emitted, -1 if none
 };
 
 // TODO: delete code bellow
@@ -868,6 +1006,7 @@ bool StackBreak_is_full(StackBreakpoint* breakpoints);
 
 typedef struct {
     BlockType items[BLOCKS_MAX];
+    int scope_depths[BLOCKS_MAX]; // NOTE: Scope depth where the block ends, 'sai' pops the locals above it
     int top;
 } StackBlock;
 
@@ -892,11 +1031,20 @@ typedef struct {
     Function** items;
 } DArrayFunction; 
 
+// Where an operand's code starts, so the constant folding can look at what
+// it compiled to and take it back.
+//
+typedef struct {
+    int instruction_offset;
+    int values_count;
+} OperandStart;
+
 typedef struct {
     Token token_current;
     Token token_previous;
     Lexer* lexer;
     LinkedList(Function) function;  // TODO: rename to 'first_function_declaration'
+    LinkedList(Function) functions_free; // NOTE: Ended Functions, reused by the next declaration
     LinkedList(ClassDeclaration) first_class_declaration; 
     HashTable* string_database;
     HashTable table_strings;
@@ -907,11 +1055,15 @@ typedef struct {
     int interpolation_count_nesting;
     int interpolation_count_value_pushed;
     int continue_jump_to;
+    int continue_scope_depth;
     StackBreakpoint breakpoints;
     StackBlock blocks;
 
     bool had_error;
     bool panic_mode;
+    bool is_building_ast; // Set by 'parser_parse' when the caller asks for the statements
+    bool is_optimizing;   // NOTE: Runs 'Bytecode_optimize' on every finished function
+    Arena arena;          // NOTE: Owns the AST and the compiler bookkeeping, see 'Parser_free'
 
     bool debugger_execution_pause;
     bool debugger_execution_resume;
@@ -956,6 +1108,7 @@ typedef struct {
     Lexer*     lexer;
     HashTable* string_database;
     Object**   object_head;
+    bool       is_optimizer_disabled; // NOTE: Keeps the bytecode as emitted, for debugging
 } ParserInitParams;
 
 #define Parser_Init(parser, source_code, ...) \
@@ -963,19 +1116,33 @@ typedef struct {
 
 void parser_init(Parser* parser, const char* source_code, ParserInitParams params);
 ObjectFunction* parser_parse(Parser* parser, ArrayStatement** return_statements, HashTable* string_database, Object** object_head);
+void Parser_free(Parser* parser);
 
 //
 // Value Stack
 //
 
-#define STACK_MAX 256
+// NOTE: The Stack starts with 'STACK_VALUE_CAPACITY' slots and doubles when a
+//       call needs more, up to 'capacity_max'. Growing moves the values, the
+//       Virtual Machine rebases the pointers into it ('FunctionCall.frame_start'
+//       and the open 'ObjectValue.value_address').
+//
+#ifndef STACK_VALUE_CAPACITY
+#define STACK_VALUE_CAPACITY 256
+#endif
+#ifndef STACK_VALUE_CAPACITY_MAX
+#define STACK_VALUE_CAPACITY_MAX (1 << 20)
+#endif
 
 typedef struct {
-    Value items[STACK_MAX];
+    Value* items;
     Value* top;
+    int capacity;
+    int capacity_max;
 } StackValue;
 
 // StackValue* stack_value_create(void);
+void  stack_value_init(StackValue* stack, int capacity, int capacity_max);
 void  stack_value_reset(StackValue* stack);
 Value stack_value_push(StackValue* stack, Value value);
 Value stack_value_pop(StackValue* stack);
@@ -983,7 +1150,7 @@ Value stack_value_peek(StackValue* stack, int offset);
 bool  stack_value_is_full(StackValue* stack);
 bool  stack_value_is_empty(StackValue* stack);
 void  stack_value_trace(StackValue* stack);
-void  stack_free(StackValue* stack);
+void  stack_value_free(StackValue* stack);
 
 //
 // Memory / Garbage Collector
@@ -1008,7 +1175,16 @@ void  stack_free(StackValue* stack);
 #define Memory_FreeArray(type, pointer, old_count) \
     Memory_allocate(pointer, sizeof(type) * old_count, 0)
 
-void  Memory_register(size_t* bytes_total_source, VirtualMachine *vm, Parser *parser);
+// NOTE: A permanent object is never traced, so it must not reference an
+//       object that can be collected. Checked where the runtime stores an
+//       object into one that may be permanent.
+//
+#define Memory_assert_reference(owner, target) \
+    assert(!(owner)->is_permanent || (target) == NULL || (target)->is_permanent)
+
+void  Memory_register(size_t* bytes_total_source, VirtualMachine *vm);
+void  Memory_begin_compilation();
+void  Memory_end_compilation(Object** object_head);
 void* Memory_allocate(void* pointer, size_t old_size, size_t new_size);
 void  Memory_mark_object_gray(Object* object);
 void  Memory_mark_value_gray(Value value);
@@ -1020,8 +1196,19 @@ void  Memory_transaction_pop();
 // Virtual Machine
 //
 
+// NOTE: Like the Value Stack, the FunctionCall Stack starts small and grows
+//       up to 'capacity_max'. Both maximums can be changed when the Virtual
+//       Machine is initialized.
+//
 #define FRAME_MAX 64
+#ifndef FRAME_STACK_MAX
 #define FRAME_STACK_MAX (FRAME_MAX * UINT8_COUNT)
+#endif
+
+// NOTE: Slots reserved above the deepest point of each function, for the
+//       values the runtime pushes on its own (see 'Memory_transaction_push').
+//
+#define STACK_VALUE_HEADROOM 8
 
 typedef enum
 {
@@ -1037,16 +1224,20 @@ typedef struct {
 } FunctionCall;
 
 typedef struct {
-    FunctionCall items[FRAME_STACK_MAX];
+    FunctionCall* items;
     int top;
+    int capacity;
+    int capacity_max;
 } StackFunctionCall;
 
+void StackFunctionCall_init(StackFunctionCall* function_calls, int capacity, int capacity_max);
 void StackFunctionCall_reset(StackFunctionCall* function_calls);
 FunctionCall* StackFunctionCall_push(StackFunctionCall* function_calls, ObjectClosure* closure, Value* stack_value_top, int argument_count);
 FunctionCall* StackFunctionCall_pop(StackFunctionCall* function_calls);
 FunctionCall* StackFunctionCall_peek(StackFunctionCall* function_calls, int offset);
 bool StackFunctionCall_is_empty(StackFunctionCall* function_calls);
 bool StackFunctionCall_is_full(StackFunctionCall* function_calls);
+void StackFunctionCall_free(StackFunctionCall* function_calls);
 
 // Forward Declared in line: 343 in Object's section
 //
@@ -1054,10 +1245,15 @@ struct VirtualMachine {
     StackFunctionCall function_calls;
     StackValue stack_value; // TODO: rename to stack_values
     LinkedList(Object) objects;
+    LinkedList(Object) objects_permanent; // NOTE: Allocated before execution started, never collected
 
     // Heap Values tracker
     //
-    LinkedList(ObjectValue) heap_values;
+    // NOTE: One entry per slot of the Stack: the ObjectValue that captured
+    //       the slot, while the value is still on the Stack, NULL otherwise.
+    //       Same capacity as the Stack.
+    //
+    ObjectValue** heap_values;
 
     // Stores global variables 
     //
@@ -1071,7 +1267,15 @@ struct VirtualMachine {
     ObjectString* object_init_string;
 };
 
-void VirtualMachine_init(VirtualMachine* vm);
+typedef struct {
+    int stack_value_max;    // NOTE: Values on the Stack, 0 for 'STACK_VALUE_CAPACITY_MAX'
+    int function_calls_max; // NOTE: Nested calls, 0 for 'FRAME_STACK_MAX'
+} VirtualMachineInitParams;
+
+#define VirtualMachine_Init(vm, ...) \
+    VirtualMachine_init((vm), (VirtualMachineInitParams){__VA_ARGS__})
+
+void VirtualMachine_init(VirtualMachine* vm, VirtualMachineInitParams params);
 InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* script);
 void VirtualMachine_free(VirtualMachine* vm);
 
@@ -1,8 +1,51 @@
 #include "kriolu.h"
 
 #define LEXER_MEMORY_POOL_MAX 25
-#define lexer_keyword_kind(token, keyword, check_start_position, return_kind) \
-    lexer_keyword_kind_custom(token, keyword, check_start_position, return_kind, Token_Identifier)
+
+// Keywords:
+//     A perfect hash over the first character, the last character and the
+//     length of the identifier: every keyword lands on its own slot, so an
+//     identifier costs one hash and at most one compare. The multipliers
+//     were found by searching for the first collision-free combination.
+//     Adding a keyword means adding it to the table and checking that its
+//     slot is still free (or searching again).
+//
+#define LEXER_KEYWORD_LENGTH_MAX 7
+#define LEXER_KEYWORD_TABLE_SIZE 32
+#define LEXER_KEYWORD_HASH(first, last, length) \
+    (((first) + (last) * 22 + (length) * 14) & (LEXER_KEYWORD_TABLE_SIZE - 1))
+
+typedef struct
+{
+    const char* characters;
+    int length;
+    TokenKind kind;
+} LexerKeyword;
+
+static const LexerKeyword lexer_keyword_table[LEXER_KEYWORD_TABLE_SIZE] = {
+    [LEXER_KEYWORD_HASH('e', 'e', 1)] = { "e",       1, Token_E              },
+    [LEXER_KEYWORD_HASH('o', 'u', 2)] = { "ou",      2, Token_Ou             },
+    [LEXER_KEYWORD_HASH('k', 'a', 2)] = { "ka",      2, Token_Ka             },
+    [LEXER_KEYWORD_HASH('s', 'i', 2)] = { "si",      2, Token_Si             },
+    [LEXER_KEYWORD_HASH('d', 'i', 2)] = { "di",      2, Token_Di             },
+    [LEXER_KEYWORD_HASH('t', 'i', 2)] = { "ti",      2, Token_Ti             },
+    [LEXER_KEYWORD_HASH('p', 'a', 2)] = { "pa",      2, Token_Pa             },
+    [LEXER_KEYWORD_HASH('s', 'i', 3)] = { "sai",     3, Token_Sai            },
+    [LEXER_KEYWORD_HASH('k', 'i', 4)] = { "keli",    4, Token_Keli           },
+    [LEXER_KEYWORD_HASH('n', 'o', 4)] = { "nulo",    4, Token_Nulo           },
+    [LEXER_KEYWORD_HASH('r', 'a', 4)] = { "riba",    4, Token_Riba           },
+    [LEXER_KEYWORD_HASH('k', 'i', 5)] = { "klasi",   5, Token_Klasi          },
+    [LEXER_KEYWORD_HASH('s', 'u', 5)] = { "sinou",   5, Token_Sinou          },
+    [LEXER_KEYWORD_HASH('s', 'a', 5)] = { "salta",   5, Token_Salta          },
+    [LEXER_KEYWORD_HASH('f', 'u', 5)] = { "falsu",   5, Token_Falsu          },
+    [LEXER_KEYWORD_HASH('d', 'g', 5)] = { "debug",   5, Token_Debugger_Break },
+    [LEXER_KEYWORD_HASH('f', 'n', 6)] = { "funson",  6, Token_Funson         },
+    [LEXER_KEYWORD_HASH('d', 'i', 7)] = { "divolvi", 7, Token_Divolvi        },
+    [LEXER_KEYWORD_HASH('t', 'i', 7)] = { "timenti", 7, Token_Timenti        },
+    [LEXER_KEYWORD_HASH('i', 'i', 7)] = { "imprimi", 7, Token_Imprimi        },
+    [LEXER_KEYWORD_HASH('v', 'i', 7)] = { "verdadi", 7, Token_Verdadi        },
+    [LEXER_KEYWORD_HASH('m', 'a', 7)] = { "mimoria", 7, Token_Mimoria        },
+};
 
 typedef struct
 {
@@ -12,6 +55,110 @@ typedef struct
 
 static LexerMemoryPool lexer_memory_pool[LEXER_MEMORY_POOL_MAX];
 
+// Character Classes:
+//     'lexer_scan' looks the first character of a token up in a 256-entry
+//     table and switches on its class, instead of testing it against each
+//     predicate in turn. Characters that are a token on their own map to
+//     their Token Kind through 'lexer_single_character_kind'. Bytes outside
+//     ASCII are 'LexerCharacter_Invalid'.
+//
+typedef enum
+{
+    LexerCharacter_Invalid,
+    LexerCharacter_Eof,
+    LexerCharacter_Whitespace,
+    LexerCharacter_New_Line,
+    LexerCharacter_Digit,
+    LexerCharacter_Letter,      // letters and '_'
+    LexerCharacter_Quote,
+    LexerCharacter_Dollar,
+    LexerCharacter_Single,      // ( ) { , . - + * ^ ;
+    LexerCharacter_Slash,       // '/' or the start of a comment
+    LexerCharacter_Right_Brace, // '}' or the end of a string interpolation
+    LexerCharacter_Equal,
+    LexerCharacter_Greater,
+    LexerCharacter_Less,
+} LexerCharacter;
+
+#define IV LexerCharacter_Invalid
+#define EF LexerCharacter_Eof
+#define WS LexerCharacter_Whitespace
+#define NL LexerCharacter_New_Line
+#define DG LexerCharacter_Digit
+#define LT LexerCharacter_Letter
+#define QT LexerCharacter_Quote
+#define DL LexerCharacter_Dollar
+#define SG LexerCharacter_Single
+#define SL LexerCharacter_Slash
+#define RB LexerCharacter_Right_Brace
+#define EQ LexerCharacter_Equal
+#define GT LexerCharacter_Greater
+#define LS LexerCharacter_Less
+
+static const uint8_t lexer_character_class[256] = {
+//  0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F
+    EF, IV, IV, IV, IV, IV, IV, IV, IV, WS, NL, IV, IV, WS, IV, IV, // 0x00
+    IV, IV, IV, IV, IV, IV, IV, IV, IV, IV, IV, IV, IV, IV, IV, IV, // 0x10
+    WS, IV, QT, IV, DL, IV, IV, IV, SG, SG, SG, SG, SG, SG, SG, SL, // 0x20  !"#$%&'()*+,-./
+    DG, DG, DG, DG, DG, DG, DG, DG, DG, DG, IV, SG, LS, EQ, GT, IV, // 0x30 0123456789:;<=>?
+    IV, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, // 0x40 @ABCDEFGHIJKLMNO
+    LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, IV, IV, IV, SG, LT, // 0x50 PQRSTUVWXYZ[\]^_
+    IV, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, // 0x60 `abcdefghijklmno
+    LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, SG, IV, RB, IV, IV, // 0x70 pqrstuvwxyz{|}~
+};
+
+#undef IV
+#undef EF
+#undef WS
+#undef NL
+#undef DG
+#undef LT
+#undef QT
+#undef DL
+#undef SG
+#undef SL
+#undef RB
+#undef EQ
+#undef GT
+#undef LS
+
+static const uint8_t lexer_single_character_kind[128] = {
+    ['('] = Token_Left_Parenthesis,
+    [')'] = Token_Right_Parenthesis,
+    ['{'] = Token_Left_Brace,
+    [','] = Token_Comma,
+    ['.'] = Token_Dot,
+    ['-'] = Token_Minus,
+    ['+'] = Token_Plus,
+    ['*'] = Token_Asterisk,
+    ['^'] = Token_Caret,
+    [';'] = Token_Semicolon,
+};
+
+// Skipping:
+//     Runs of whitespace, comment bodies, identifiers and string bodies are
+//     scanned 16 bytes at a time with SSE2: the block is compared against
+//     the characters that end the run and the first match comes out of the
+//     movemask. The loads are unaligned and may read past the '\0' at the
+//     end of the source, so a block is only loaded when it doesn't cross a
+//     page boundary; near the end of a page the scan goes one byte at a
+//     time into the next page.
+//
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEXER_SSE2
+#include <emmintrin.h>
+#endif
+
+// NOTE: Most whitespace runs are a single space and most identifiers are a
+//       few characters long, for those a block compare costs more than it
+//       saves. The first characters are checked one at a time and only the
+//       longer runs go to SSE2.
+//
+#define LEXER_BLOCK_SIZE 16
+#define LEXER_PAGE_SIZE  4096
+#define LEXER_WHITESPACE_SCALAR_MAX 2
+#define LEXER_IDENTIFIER_SCALAR_MAX 8
+
 static char lexer_advance(Lexer* lexer);
 static Token lexer_advance_then_make_token(Lexer* lexer, TokenKind kind);
 static bool lexer_advance_if_match(Lexer* lexer, char expected, int offset);
@@ -27,8 +174,11 @@ static bool lexer_is_letter_lowercase(char c);
 static bool lexer_is_whitespace(char c);
 static bool lexer_is_comment(Lexer* lexer);
 static bool lexer_is_new_line(char c);
-static bool lexer_is_string(char c);
-// static TokenKind lexer_keyword_kind(Token token, char const* keyword, int check_start_position, TokenKind return_kind);
+static const char* lexer_skip_whitespace(Lexer* lexer, const char* current);
+static const char* lexer_skip_comment(const char* current);
+static const char* lexer_skip_identifier(const char* current);
+static const char* lexer_skip_string(const char* current);
+static TokenKind lexer_keyword_kind(Token token);
 static TokenKind lexer_keyword_kind_custom(Token token, char const* keyword, int check_start_position, TokenKind return_kind, TokenKind return_kind_default);
 
 Lexer* lexer_create_static()
@@ -58,51 +208,30 @@ void lexer_init(Lexer* lexer, const char* source_code)
 
 Token lexer_scan(Lexer* lexer)
 {
-    while (lexer_is_whitespace(*lexer->current))
-    {
-        if (lexer_is_new_line(*lexer->current))
-        {
-            lexer->line_number += 1;
-        }
-
-        lexer_advance(lexer);
-    }
-
+    lexer->current = lexer_skip_whitespace(lexer, lexer->current);
     lexer->start = lexer->current;
 
-    if (lexer_is_comment(lexer))
+    char character = *lexer->current;
+    switch (lexer_character_class[(uint8_t)character])
     {
-        int length;
+    case LexerCharacter_Eof:
+        return lexer_make_token(lexer, Token_Eof);
 
-        while (!lexer_is_new_line(*lexer->current) && !lexer_is_eof(*lexer->current))
-        {
-            lexer_advance(lexer);
-        }
+    case LexerCharacter_Single:
+        return lexer_advance_then_make_token(lexer, lexer_single_character_kind[(uint8_t)character]);
 
-        if (lexer->current[-1] == '\r')
-        {
-            length = (int)((lexer->current - 1) - (lexer->start));
-        } else
+    case LexerCharacter_Slash:
+    {
+        if (lexer_is_comment(lexer))
         {
-            length = (int)(lexer->current - lexer->start);
+            lexer->current = lexer_skip_comment(lexer->current + 2);
+            return lexer_make_token(lexer, Token_Comment);
         }
 
-        return lexer_make_token(lexer, Token_Comment);
+        return lexer_advance_then_make_token(lexer, Token_Slash);
     }
 
-    if (lexer_is_eof(*lexer->current))
-        return lexer_make_token(lexer, Token_Eof);
-
-    if (*lexer->current == '(')
-        return lexer_advance_then_make_token(lexer, Token_Left_Parenthesis);
-
-    if (*lexer->current == ')')
-        return lexer_advance_then_make_token(lexer, Token_Right_Parenthesis);
-
-    if (*lexer->current == '{')
-        return lexer_advance_then_make_token(lexer, Token_Left_Brace);
-
-    if (*lexer->current == '}')
+    case LexerCharacter_Right_Brace:
     {
         if (lexer->string_interpolation_count > 0)
         {
@@ -118,31 +247,7 @@ Token lexer_scan(Lexer* lexer)
         return lexer_advance_then_make_token(lexer, Token_Right_Brace);
     }
 
-    if (*lexer->current == ',')
-        return lexer_advance_then_make_token(lexer, Token_Comma);
-
-    if (*lexer->current == '.')
-        return lexer_advance_then_make_token(lexer, Token_Dot);
-
-    if (*lexer->current == '-')
-        return lexer_advance_then_make_token(lexer, Token_Minus);
-
-    if (*lexer->current == '+')
-        return lexer_advance_then_make_token(lexer, Token_Plus);
-
-    if (*lexer->current == '/')
-        return lexer_advance_then_make_token(lexer, Token_Slash);
-
-    if (*lexer->current == '*')
-        return lexer_advance_then_make_token(lexer, Token_Asterisk);
-
-    if (*lexer->current == '^')
-        return lexer_advance_then_make_token(lexer, Token_Caret);
-
-    if (*lexer->current == ';')
-        return lexer_advance_then_make_token(lexer, Token_Semicolon);
-
-    if (*lexer->current == '=')
+    case LexerCharacter_Equal:
     {
         Token token;
         token.start = lexer->current;
@@ -171,7 +276,7 @@ Token lexer_scan(Lexer* lexer)
         return token;
     }
 
-    if (*lexer->current == '>')
+    case LexerCharacter_Greater:
     {
         Token token;
         token.start = lexer->current;
@@ -193,7 +298,7 @@ Token lexer_scan(Lexer* lexer)
         return token;
     }
 
-    if (*lexer->current == '<')
+    case LexerCharacter_Less:
     {
         Token token;
         token.start = lexer->current;
@@ -215,17 +320,13 @@ Token lexer_scan(Lexer* lexer)
         return token;
     }
 
-    if (*lexer->current == '$') {
+    case LexerCharacter_Dollar:
+    {
         Token token = {0};
         token.kind = Token_Debugger;
         token.start = lexer->current;
         token.line_number = lexer->line_number;
-        for (;;) {
-            lexer_advance(lexer);
-            if (lexer_is_letter_or_underscore(*lexer->current)) continue;
-            if (lexer_is_digit(*lexer->current)) continue;
-            break;
-        }
+        lexer->current = lexer_skip_identifier(lexer->current + 1);
         token.length = (int)(lexer->current - token.start);
 
         if (token.start[1] == 'b') {
@@ -244,7 +345,7 @@ Token lexer_scan(Lexer* lexer)
         return token;
     }
 
-    if (lexer_is_digit(*lexer->current))
+    case LexerCharacter_Digit:
     {
         while (lexer_is_digit(*lexer->current))
             lexer_advance(lexer);
@@ -260,109 +361,22 @@ Token lexer_scan(Lexer* lexer)
         return lexer_make_token(lexer, Token_Number);
     }
 
-    if (lexer_is_string(*lexer->current))
+    case LexerCharacter_Quote:
         return lexer_read_string(lexer);
 
-    if (lexer_is_letter_or_underscore(*lexer->current))
+    case LexerCharacter_Letter:
     {
         Token token;
-        token.kind = Token_Identifier;
         token.start = lexer->current;
         token.line_number = lexer->line_number;
 
-        while (lexer_is_letter_or_underscore(*lexer->current) || lexer_is_digit(*lexer->current))
-        {
-            lexer_advance(lexer);
-        }
-
+        lexer->current = lexer_skip_identifier(lexer->current + 1);
         token.length = (int)(lexer->current - token.start);
-
-        if (*token.start == 'e') {
-            token.kind = lexer_keyword_kind(token, "e", 0, Token_E);
-        }
-        else if (*token.start == 'o') {
-            token.kind = lexer_keyword_kind(token, "ou", 1, Token_Ou);
-        }
-        else if (*token.start == 'k') {
-            if (token.start[1] == 'a') {
-                token.kind = lexer_keyword_kind(token, "ka", 1, Token_Ka);
-            } 
-            else if (token.start[1] == 'l') {
-                token.kind = lexer_keyword_kind(token, "klasi", 2, Token_Klasi);
-            } 
-            else if (token.start[1] == 'e') {
-                token.kind = lexer_keyword_kind(token, "keli", 2, Token_Keli);
-            }
-        }
-        else if (*token.start == 's') {
-            if (token.start[1] == 'i') {
-                if (token.start[2] == 'n') {
-                    token.kind = lexer_keyword_kind(token, "sinou", 2, Token_Sinou);
-                } 
-                else {
-                    token.kind = lexer_keyword_kind(token, "si", 2, Token_Si);
-                }
-            } 
-            else if (token.start[1] == 'a') {
-                if (token.start[2] == 'l') {
-                    token.kind = lexer_keyword_kind(token, "salta", 3, Token_Salta);
-                } 
-                else if (token.start[2] == 'i') {
-                    token.kind = lexer_keyword_kind(token, "sai", 2, Token_Sai);
-                }
-            }
-        }
-        else if (*token.start == 'f') {
-            if (token.start[1] == 'a') {
-                token.kind = lexer_keyword_kind(token, "falsu", 2, Token_Falsu);
-            } else if (token.start[1] == 'u') {
-                token.kind = lexer_keyword_kind(token, "funson", 2, Token_Funson);
-            }
-        }
-        else if (*token.start == 'd') {
-            if (token.start[1] == 'i') {
-                if (token.start[2] == 'v') {
-                    token.kind = lexer_keyword_kind(token, "divolvi", 3, Token_Divolvi);
-                } 
-                else {
-                    token.kind = lexer_keyword_kind(token, "di", 2, Token_Di);
-                }
-            } 
-            else if (token.start[1] == 'e') {
-                token.kind = lexer_keyword_kind(token, "debug", 2, Token_Debugger_Break);
-            }
-        }
-        else if (*token.start == 't') {
-            if (token.start[1] == 'i') {
-                if (token.start[2] == 'm') {
-                    token.kind = lexer_keyword_kind(token, "timenti", 3, Token_Timenti);
-                }
-                else {
-                    token.kind = lexer_keyword_kind(token, "ti", 2, Token_Ti);
-                }
-            }
-        }
-        else if (*token.start == 'i') {
-            token.kind = lexer_keyword_kind(token, "imprimi", 1, Token_Imprimi);
-        }
-        else if (*token.start == 'v') {
-            token.kind = lexer_keyword_kind(token, "verdadi", 1, Token_Verdadi);
-        }
-        else if (*token.start == 'm') {
-            token.kind = lexer_keyword_kind(token, "mimoria", 1, Token_Mimoria);
-        } 
-        else if (*token.start == 'n') {
-            token.kind = lexer_keyword_kind(token, "nulo", 1, Token_Nulo);
-        } 
-        else if (*token.start == 'p') {
-            token.kind = lexer_keyword_kind(token, "pa", 1, Token_Pa);
-        }
-        else if (*token.start == 'r') {
-            token.kind = lexer_keyword_kind(token, "riba", 1, Token_Riba);
-        }
+        token.kind = lexer_keyword_kind(token);
 
         return token;
     }
+    }
 
     return lexer_make_error_and_advance(lexer, "'%c' : Lexer doesn't recognize this character.", *lexer->current);
 }
@@ -666,7 +680,7 @@ static Token lexer_read_string(Lexer* lexer)
 
     for (;;)
     {
-        lexer_advance(lexer);
+        lexer->current = lexer_skip_string(lexer->current + 1);
 
         if (*lexer->current == '"')
             break;
@@ -706,11 +720,8 @@ static bool lexer_is_eof(char c)
 
 static bool lexer_is_whitespace(char c)
 {
-    return (c == ' ') ||
-        (c == '\t') ||
-        (c == '\n') ||
-        (c == '\r');
-    //    || (c == '/');
+    uint8_t character_class = lexer_character_class[(uint8_t)c];
+    return character_class == LexerCharacter_Whitespace || character_class == LexerCharacter_New_Line;
 }
 
 static bool lexer_is_comment(Lexer* lexer)
@@ -734,20 +745,11 @@ static bool lexer_is_new_line(char c)
 }
 
 static bool lexer_is_digit(char c) {
-    return (c >= '0' && c <= '9');
-}
-
-static bool lexer_is_string(char c)
-{
-    return (c == '"');
+    return lexer_character_class[(uint8_t)c] == LexerCharacter_Digit;
 }
 
 static bool lexer_is_letter_or_underscore(char c) {
-    if (c == '_')             return true;
-    if (c >= 'a' && c <= 'z') return true;
-    if (c >= 'A' && c <= 'Z') return true;
-
-    return false;
+    return lexer_character_class[(uint8_t)c] == LexerCharacter_Letter;
 }
 
 static bool lexer_is_letter_uppercase(char c) {
@@ -764,7 +766,216 @@ static bool lexer_is_letter_lowercase(char c) {
     return false;
 }
 
-// static TokenKind lexer_keyword_kind(Token token, char const* keyword, int check_start_position, TokenKind return_kind)
+static inline bool lexer_can_load_block(const char* current)
+{
+    return ((uintptr_t)current & (LEXER_PAGE_SIZE - 1)) <= LEXER_PAGE_SIZE - LEXER_BLOCK_SIZE;
+}
+
+#ifdef LEXER_SSE2
+static inline int lexer_count_trailing_zeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static inline int lexer_count_bits(uint32_t mask)
+{
+    int count = 0;
+    for (; mask != 0; mask &= mask - 1)
+        count += 1;
+
+    return count;
+}
+#endif // LEXER_SSE2
+
+// Skips ' ', '\t', '\r' and '\n', counting the new lines.
+//
+static const char* lexer_skip_whitespace(Lexer* lexer, const char* current)
+{
+    for (int i = 0; i < LEXER_WHITESPACE_SCALAR_MAX; i++)
+    {
+        if (!lexer_is_whitespace(*current))
+            return current;
+
+        if (lexer_is_new_line(*current))
+            lexer->line_number += 1;
+
+        current += 1;
+    }
+
+    for (;;)
+    {
+#ifdef LEXER_SSE2
+        if (lexer_can_load_block(current))
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)current);
+            __m128i new_line = _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'));
+            __m128i whitespace = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\r')), new_line)
+            );
+
+            uint32_t new_lines = (uint32_t)_mm_movemask_epi8(new_line);
+            uint32_t end = ~(uint32_t)_mm_movemask_epi8(whitespace) & 0xFFFF;
+            if (end != 0)
+            {
+                int index = lexer_count_trailing_zeros(end);
+                lexer->line_number += lexer_count_bits(new_lines & ((1u << index) - 1));
+                return current + index;
+            }
+
+            lexer->line_number += lexer_count_bits(new_lines);
+            current += LEXER_BLOCK_SIZE;
+            continue;
+        }
+#endif // LEXER_SSE2
+
+        if (!lexer_is_whitespace(*current))
+            return current;
+
+        if (lexer_is_new_line(*current))
+            lexer->line_number += 1;
+
+        current += 1;
+    }
+}
+
+// Returns the '\n' or the '\0' that ends the comment.
+//
+static const char* lexer_skip_comment(const char* current)
+{
+    for (;;)
+    {
+#ifdef LEXER_SSE2
+        if (lexer_can_load_block(current))
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)current);
+            __m128i end = _mm_or_si128(
+                _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')),
+                _mm_cmpeq_epi8(block, _mm_setzero_si128())
+            );
+
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(end);
+            if (mask != 0)
+                return current + lexer_count_trailing_zeros(mask);
+
+            current += LEXER_BLOCK_SIZE;
+            continue;
+        }
+#endif // LEXER_SSE2
+
+        if (lexer_is_new_line(*current) || lexer_is_eof(*current))
+            return current;
+
+        current += 1;
+    }
+}
+
+// Returns the first character that is not a letter, a digit or '_'.
+//
+static const char* lexer_skip_identifier(const char* current)
+{
+    for (int i = 0; i < LEXER_IDENTIFIER_SCALAR_MAX; i++)
+    {
+        if (!lexer_is_letter_or_underscore(*current) && !lexer_is_digit(*current))
+            return current;
+
+        current += 1;
+    }
+
+    for (;;)
+    {
+#ifdef LEXER_SSE2
+        if (lexer_can_load_block(current))
+        {
+            // NOTE: OR-ing 0x20 turns 'A'-'Z' into 'a'-'z' and nothing else
+            //       into 'a'-'z'. Bytes above 0x7F are negative and fail the
+            //       signed range checks.
+            //
+            __m128i block = _mm_loadu_si128((const __m128i*)current);
+            __m128i lower = _mm_or_si128(block, _mm_set1_epi8(0x20));
+            __m128i letter = _mm_and_si128(
+                _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1))
+            );
+            __m128i digit = _mm_and_si128(
+                _mm_cmpgt_epi8(block, _mm_set1_epi8('0' - 1)),
+                _mm_cmplt_epi8(block, _mm_set1_epi8('9' + 1))
+            );
+            __m128i underscore = _mm_cmpeq_epi8(block, _mm_set1_epi8('_'));
+            __m128i identifier = _mm_or_si128(_mm_or_si128(letter, digit), underscore);
+
+            uint32_t end = ~(uint32_t)_mm_movemask_epi8(identifier) & 0xFFFF;
+            if (end != 0)
+                return current + lexer_count_trailing_zeros(end);
+
+            current += LEXER_BLOCK_SIZE;
+            continue;
+        }
+#endif // LEXER_SSE2
+
+        if (!lexer_is_letter_or_underscore(*current) && !lexer_is_digit(*current))
+            return current;
+
+        current += 1;
+    }
+}
+
+// Returns the first '"', '%', '\n' or '\0' of a string body, the characters
+// 'lexer_read_string' has to look at.
+//
+static const char* lexer_skip_string(const char* current)
+{
+    for (;;)
+    {
+#ifdef LEXER_SSE2
+        if (lexer_can_load_block(current))
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)current);
+            __m128i end = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')), _mm_cmpeq_epi8(block, _mm_set1_epi8('%'))),
+                _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(block, _mm_setzero_si128()))
+            );
+
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(end);
+            if (mask != 0)
+                return current + lexer_count_trailing_zeros(mask);
+
+            current += LEXER_BLOCK_SIZE;
+            continue;
+        }
+#endif // LEXER_SSE2
+
+        char c = *current;
+        if (c == '"' || c == '%' || lexer_is_new_line(c) || lexer_is_eof(c))
+            return current;
+
+        current += 1;
+    }
+}
+
+static TokenKind lexer_keyword_kind(Token token)
+{
+    if (token.length > LEXER_KEYWORD_LENGTH_MAX)
+        return Token_Identifier;
+
+    uint8_t first = (uint8_t)token.start[0];
+    uint8_t last  = (uint8_t)token.start[token.length - 1];
+    const LexerKeyword* keyword = &lexer_keyword_table[LEXER_KEYWORD_HASH(first, last, token.length)];
+    if (keyword->length != token.length)
+        return Token_Identifier;
+
+    if (memcmp(keyword->characters, token.start, token.length) != 0)
+        return Token_Identifier;
+
+    return keyword->kind;
+}
+
 static TokenKind lexer_keyword_kind_custom(Token token, char const* keyword, int check_start_position, TokenKind return_kind, TokenKind return_kind_default)
 {
     int keyword_length = strlen(keyword);
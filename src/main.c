@@ -1,7 +1,18 @@
 #include <stdlib.h>
+#include <limits.h>
 
 #include "kriolu.h"
 
+#if defined(_WIN32)
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
 #define RETURN_DEFER(value) \
     do                      \
     {                       \
@@ -9,13 +20,31 @@
         goto defer;         \
     } while (0)
 
+// Source File:
+//     The script is mapped read-only instead of being copied into the heap,
+//     so a large script starts without reading it all first and processes
+//     running the same script share the page cache. The lexer needs a '\0'
+//     after the last character: the mapping is one byte longer than the
+//     file, and the bytes past the end of the file in its last page are
+//     zero-filled by the OS (when the file ends on a page boundary, an extra
+//     zero page is mapped after it). If the file can't be mapped, it's read
+//     into a heap buffer like before.
+//
+typedef struct {
+    char*  characters;
+    size_t length;
+    size_t mapping_size; // 0 when 'characters' is a heap copy
+} SourceFile;
+
 void print_usage();
-int  file_read(const char* file_path, char** buffer_out);
+int  file_read(const char* file_path, SourceFile* file_out);
+int  file_read_copy(const char* file_path, SourceFile* file_out);
+void file_close(SourceFile* file);
 bool filename_ends_with(const char* filename, const char* extension);
 void token_print(Token token);
 
 int main(int argc, const char* argv[]) {
-    char* source_code = NULL;
+    SourceFile source_file = { 0 };
 
     if (argc < 2) {
         fprintf(stderr, "Error: few arguments to run.\n\n");
@@ -37,6 +66,8 @@ int main(int argc, const char* argv[]) {
 #else 
         printf("Kriolu: version 1.0.0 release mode");
 #endif
+        string_kernel_init();
+        printf("\nString kernels: %s", string_kernel_get()->name);
         return 0;
     }
 
@@ -55,16 +86,23 @@ int main(int argc, const char* argv[]) {
         exit(EXIT_FAILURE);
     }
 
-    int result = file_read(argv[1], &source_code);
+    int result = file_read(argv[1], &source_file);
     if (result <= 0) exit(EXIT_FAILURE);
-
-    bool is_flag_lexer    = false;
-    bool is_flag_parser   = false;
-    bool is_flag_bytecode = false;
+    const char* source_code = source_file.characters;
+
+    bool is_flag_lexer       = false;
+    bool is_flag_parser      = false;
+    bool is_flag_bytecode    = false;
+    bool is_flag_no_optimize = false;
+    int  stack_value_max     = 0;
+    int  function_calls_max  = 0;
     for (int i = 2; i < argc; i++) {
-        if (strcmp(argv[i], "-lexer") == 0)         is_flag_lexer    = true;
-        else if (strcmp(argv[i], "-parser") == 0)   is_flag_parser   = true;
-        else if (strcmp(argv[i], "-bytecode") == 0) is_flag_bytecode = true;
+        if (strcmp(argv[i], "-lexer") == 0)            is_flag_lexer       = true;
+        else if (strcmp(argv[i], "-parser") == 0)      is_flag_parser      = true;
+        else if (strcmp(argv[i], "-bytecode") == 0)    is_flag_bytecode    = true;
+        else if (strcmp(argv[i], "-no-optimize") == 0) is_flag_no_optimize = true;
+        else if (strcmp(argv[i], "-stack-max") == 0 && i + 1 < argc) stack_value_max    = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-calls-max") == 0 && i + 1 < argc) function_calls_max = atoi(argv[++i]);
     }
 
     if (is_flag_lexer) {
@@ -77,12 +115,17 @@ int main(int argc, const char* argv[]) {
     Parser parser;
     VirtualMachine vm = { 0 };
 
-    VirtualMachine_init(&vm);
+    VirtualMachine_Init(
+        &vm,
+        .stack_value_max = stack_value_max,
+        .function_calls_max = function_calls_max
+    );
     Parser_Init(
         &parser, 
         source_code, 
         .string_database = &vm.string_database, 
-        .object_head = &vm.objects
+        .object_head = &vm.objects,
+        .is_optimizer_disabled = is_flag_no_optimize
     );
 
     if (is_flag_parser) {
@@ -93,11 +136,14 @@ int main(int argc, const char* argv[]) {
             printf("\n");
         }
 
+        Parser_free(&parser);
+
         return 0;
     }
 
     if (is_flag_bytecode) {
         ObjectFunction* script = parser_parse(&parser, NULL, &vm.string_database, &vm.objects);
+        Parser_free(&parser);
         Bytecode_disassemble(&script->bytecode, "Script");
         // Bytecode_free(&bytecode);
         return 0;
@@ -107,6 +153,7 @@ int main(int argc, const char* argv[]) {
     //
     // ObjectFunction* script = parser_parse(&parser, NULL, &vm.string_database, &vm.objects);
     ObjectFunction* script = parser_parse(&parser, NULL, NULL, NULL);
+    Parser_free(&parser);
     
     assert(
         (vm.stack_value.top == vm.stack_value.items) && 
@@ -117,11 +164,112 @@ int main(int argc, const char* argv[]) {
 
     // Bytecode_free(&bytecode);
     // vm_free();
+    file_close(&source_file);
     return 0;
 }
 
-int file_read(const char* file_path, char** buffer_out) {
+#if defined(_WIN32)
+int file_read(const char* file_path, SourceFile* file_out) {
+    int result = 0;
+    HANDLE file = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    HANDLE mapping = NULL;
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        fprintf(stderr, "Error: Could not open file \"%s\".\n", file_path);
+        RETURN_DEFER(-1);
+    }
+
+    LARGE_INTEGER file_size = { 0 };
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart > INT_MAX)
+        RETURN_DEFER(file_read_copy(file_path, file_out));
+
+    if (file_size.QuadPart == 0)
+    {
+        fprintf(stderr, "Error: File is empty.\n");
+        RETURN_DEFER(0);
+    }
+
+    // NOTE: A view can't be followed by a page of our own, so a file that
+    //       ends on a page boundary has no zero byte after it. Copy those.
+    //
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    if (file_size.QuadPart % system_info.dwPageSize == 0)
+        RETURN_DEFER(file_read_copy(file_path, file_out));
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+        RETURN_DEFER(file_read_copy(file_path, file_out));
+
+    char* characters = (char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (characters == NULL)
+        RETURN_DEFER(file_read_copy(file_path, file_out));
+
+    file_out->characters   = characters;
+    file_out->length       = (size_t)file_size.QuadPart;
+    file_out->mapping_size = (size_t)file_size.QuadPart;
+    result = (int)file_size.QuadPart;
+
+defer:
+    // NOTE: The view keeps the mapping alive after its handle is closed.
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    return result;
+}
+#else
+int file_read(const char* file_path, SourceFile* file_out) {
+    int result = 0;
+    int file = open(file_path, O_RDONLY);
+    if (file == -1)
+    {
+        fprintf(stderr, "Error: Could not open file \"%s\".\n", file_path);
+        RETURN_DEFER(-1);
+    }
+
+    struct stat file_status;
+    if (fstat(file, &file_status) == -1 || !S_ISREG(file_status.st_mode) || file_status.st_size > INT_MAX)
+        RETURN_DEFER(file_read_copy(file_path, file_out));
+
+    size_t file_size = (size_t)file_status.st_size;
+    if (file_size == 0)
+    {
+        fprintf(stderr, "Error: File is empty.\n");
+        RETURN_DEFER(0);
+    }
+
+    // Reserve the whole range with zero pages first, then map the file over
+    // the start of it, so the byte after the file is always a mapped '\0'.
+    //
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapping_size = (file_size + 1 + page_size - 1) & ~(page_size - 1);
+    char* characters = mmap(NULL, mapping_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (characters == MAP_FAILED)
+        RETURN_DEFER(file_read_copy(file_path, file_out));
+
+    if (mmap(characters, file_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, file, 0) == MAP_FAILED)
+    {
+        munmap(characters, mapping_size);
+        RETURN_DEFER(file_read_copy(file_path, file_out));
+    }
+
+#ifdef MADV_SEQUENTIAL
+    madvise(characters, file_size, MADV_SEQUENTIAL);
+#endif
+
+    file_out->characters   = characters;
+    file_out->length       = file_size;
+    file_out->mapping_size = mapping_size;
+    result = (int)file_size;
+
+defer:
+    if (file != -1) close(file);
+    return result;
+}
+#endif
+
+int file_read_copy(const char* file_path, SourceFile* file_out) {
     int result = 0;
+    char* buffer = NULL;
     FILE* file = fopen(file_path, "rb");
     if (file == NULL)
     {
@@ -140,29 +288,48 @@ int file_read(const char* file_path, char** buffer_out) {
         RETURN_DEFER(file_size);
     }
 
-    *buffer_out = malloc(file_size + 1);
-    if (*buffer_out == NULL)
+    buffer = malloc(file_size + 1);
+    if (buffer == NULL)
     {
         fprintf(stderr, "Error: Could not allocate buffer for the file size.\n");
         RETURN_DEFER(-1);
     }
 
-    size_t bytes_read = fread(*buffer_out, sizeof(char), file_size, file);
+    size_t bytes_read = fread(buffer, sizeof(char), file_size, file);
     if (bytes_read < file_size)
     {
         fprintf(stderr, "Error: reading contents of the file failed.\n");
         RETURN_DEFER(-1);
     }
 
-    (*buffer_out)[bytes_read] = '\0';
+    buffer[bytes_read] = '\0';
+    file_out->characters   = buffer;
+    file_out->length       = bytes_read;
+    file_out->mapping_size = 0;
     result = bytes_read;
 
 defer:
     if (file) fclose(file);
-    if (*buffer_out != NULL && result == -1) free(*buffer_out);
+    if (buffer != NULL && result == -1) free(buffer);
     return result;
 }
 
+void file_close(SourceFile* file) {
+    if (file->characters == NULL) return;
+
+    if (file->mapping_size == 0) {
+        free(file->characters);
+    } else {
+#if defined(_WIN32)
+        UnmapViewOfFile(file->characters);
+#else
+        munmap(file->characters, file->mapping_size);
+#endif
+    }
+
+    *file = (SourceFile){ 0 };
+}
+
 bool filename_ends_with(const char* filename, const char* extension) {
     int filename_length = strlen(filename);
     int extension_length = strlen(extension);
@@ -184,4 +351,7 @@ void print_usage()
     printf("  -lexer                   Sends tokens to the stdout.\n");
     printf("  -parser                  Sends AST to the stdout.\n");
     printf("  -bytecode                Sends bytecodes to the stdout.\n");
+    printf("  -no-optimize             Keeps the bytecode as the compiler emitted it.\n");
+    printf("  -stack-max <count>       Most values the Stack can grow to.\n");
+    printf("  -calls-max <count>       Most nested function calls.\n");
 }
@@ -27,7 +27,8 @@ typedef struct {
 size_t             bytes_total      = 0;
 size_t             bytes_threshold  = Megabytes(2); 
 size_t            *M_bytes_total    = &bytes_total;
-Parser            *M_parser         = NULL;
+bool               M_is_compiling   = false;
+bool               M_is_collecting  = false;
 VirtualMachine    *M_vm             = NULL;
 DynamincArrayGray  M_Greys          = {0};
 
@@ -40,16 +41,64 @@ static void Memory_sweep_string_database();
 static void Memory_sweep();
 static void Memory_free_object(Object* object);
 
-void Memory_register(size_t* bytes_total_source, VirtualMachine *vm, Parser *parser) {
+void Memory_register(size_t* bytes_total_source, VirtualMachine *vm) {
     if (M_bytes_total == NULL) 
     if (bytes_total_source != NULL) 
         M_bytes_total = bytes_total_source;; 
     
     if (M_vm == NULL && vm)
         M_vm = vm;
+}
+
+// NOTE: Between 'Memory_begin_compilation' and 'Memory_end_compilation' no
+//       collection runs, so the compiler doesn't have to root what it is
+//       building. At the end, every object allocated so far (the compiled
+//       functions, their constants, the interned identifiers, and what the
+//       Virtual Machine set up before) moves to 'objects_permanent' and
+//       stays marked: the mark phase stops at them and the sweep never
+//       walks them. They are never traced either, so a permanent object
+//       must never reference an object allocated at runtime: a store of
+//       that kind goes through 'Memory_assert_reference'.
+//
+void Memory_begin_compilation() {
+    M_is_compiling = true;
+}
+
+void Memory_end_compilation(Object** object_head) {
+    if (M_vm == NULL || object_head != &M_vm->objects) {
+        M_is_compiling = false;
+        return;
+    }
+
+    // NOTE: The shared closure of a function with no outsiders is made here,
+    //       still compiling, so it's permanent along with its function. Made
+    //       at runtime, it would hang from a permanent function that is never
+    //       traced, and be swept while still in use.
+    //
+    for (Object* object = M_vm->objects; object != NULL; object = object->next) {
+        if (object->kind != ObjectKind_Function) continue;
+
+        ObjectFunction* function = (ObjectFunction*)object;
+        if (function->outsiders_count == 0 && function->closure_shared == NULL)
+            function->closure_shared = ObjectClosure_allocate(function, &M_vm->objects);
+    }
+
+    M_is_compiling = false;
+
+    while (M_vm->objects != NULL) {
+        Object* object = M_vm->objects;
+        M_vm->objects = object->next;
+
+        object->is_marked    = true;
+        object->is_permanent = true;
+        LinkedList_push(M_vm->objects_permanent, object);
+    }
 
-    if (M_parser == NULL && parser) 
-        M_parser = parser;
+    // NOTE: The permanent bytes can't be collected, so the first collection
+    //       waits at least until the heap doubles from here.
+    //
+    if (bytes_threshold < *M_bytes_total * Memory_Threshold_Growth_Factor)
+        bytes_threshold = *M_bytes_total * Memory_Threshold_Growth_Factor;
 }
 
 void* Memory_allocate(void* pointer, size_t old_size, size_t new_size) {
@@ -58,7 +107,11 @@ void* Memory_allocate(void* pointer, size_t old_size, size_t new_size) {
 
     *M_bytes_total += new_size - old_size;
 
-    if (is_allocation) 
+    // NOTE: The collection itself can allocate, e.g. the strings database
+    //       shrinks while it's swept. A collection started from there would
+    //       unmark live objects that the outer sweep then frees.
+    //
+    if (is_allocation && !M_is_compiling && !M_is_collecting) 
     {
 
 #ifdef DEBUG_GC_STRESS
@@ -98,11 +151,15 @@ static void Memory_collect_garbage() {
     size_t size_before = *M_bytes_total;
 #endif // DEBUG_GC_TRACE
 
+    M_is_collecting = true;
+
     Memory_mark_roots();        // NOTE: Mark objects as 'Gray'.
     Memory_blacken_objects();   //       Mark objects as 'Black'
     Memory_sweep_string_database();
     Memory_sweep();
 
+    M_is_collecting = false;
+
     bytes_threshold = *M_bytes_total * Memory_Threshold_Growth_Factor;
 
 #ifdef DEBUG_GC_TRACE
@@ -138,16 +195,8 @@ static void Memory_mark_roots() {
 
     // Mark HeapValues
     //
-    LinkedList_foreach(ObjectValue, M_vm->heap_values, object_value) {
-        Memory_mark_object_gray((Object*)object_value.curr);
-    }
-
-    // Mark Parser's functions chains
-    // 
-    if (M_parser) {
-        LinkedList_foreach(Function, M_parser->function, function) {
-            Memory_mark_object_gray((Object*)function.curr->object);
-        }
+    for (int i = 0; i < StackPointer_count(&M_vm->stack_value); i++) {
+        Memory_mark_object_gray((Object*)M_vm->heap_values[i]);
     }
 
     Memory_mark_object_gray((Object*)M_vm->object_init_string);
@@ -174,9 +223,10 @@ static void Memory_mark_value_gray(Value value) {
 
 static void Memory_mark_hashtable_gray(HashTable* table) {
     for (int i = 0; i < table->capacity; i++) {
-        Entry *entry = &table->items[i];
-        Memory_mark_object_gray((Object*)entry->key);
-        Memory_mark_value_gray(entry->value);
+        if (table->keys[i] == NULL) continue;
+
+        Memory_mark_object_gray((Object*)table->keys[i]);
+        Memory_mark_value_gray(table->values[i]);
     }
 }
 
@@ -198,13 +248,14 @@ static void Memory_blacken_objects() {
         case ObjectKind_Closure: {
             ObjectClosure *closure = (ObjectClosure*)object;
             Memory_mark_object_gray((Object*)closure->function);
-            for (int i = 0; i < closure->heap_values.count; i++) {
-                Memory_mark_object_gray((Object*)closure->heap_values.items[i]);
+            for (int i = 0; i < closure->heap_values_count; i++) {
+                Memory_mark_object_gray((Object*)closure->heap_values[i]);
             }
         } break;
         case ObjectKind_Function: {
             ObjectFunction *function = (ObjectFunction*)object;
             Memory_mark_object_gray((Object*)function->name);
+            Memory_mark_object_gray((Object*)function->closure_shared);
             Memory_mark_values_gray(&function->bytecode.values); 
         } break;
         case ObjectKind_Heap_Value: {
@@ -219,6 +270,7 @@ static void Memory_blacken_objects() {
             ObjectInstance* instance = (ObjectInstance*)object;
             Memory_mark_object_gray((Object*)instance->klass);
             Memory_mark_hashtable_gray(&instance->fields);
+            Memory_mark_hashtable_gray(&instance->methods_bound);
         } break;
         case ObjectKind_Method: {
             ObjectMethod* obj_method = (ObjectMethod*)object;
@@ -238,42 +290,35 @@ static void Memory_blacken_objects() {
     }
 }
 
+static bool Memory_is_string_unmarked(ObjectString* key, Value value) {
+    return key->object.is_marked == false;
+}
+
 static void Memory_sweep_string_database() {
-    for (int i = 0; i < M_vm->string_database.capacity; i++) {
-        Entry *entry = &M_vm->string_database.items[i];
-        if (entry->key != NULL) 
-        if (entry->key->object.is_marked == false) 
-        {
-            hash_table_delete(&M_vm->string_database, entry->key);
-        }
-    }
+    hash_table_delete_if(&M_vm->string_database, &Memory_is_string_unmarked);
 }
 
+// NOTE: 'LinkedList_foreach' steps through 'curr->next' after the body, so
+//       it can't be used here: the body frees 'curr'.
+//
 static void Memory_sweep() {
-    LinkedList_foreach(Object, M_vm->objects, object) {
-        if (object.curr->is_marked) {
-            object.curr->is_marked = false;
+    Object *previous = NULL;
+    Object *current  = M_vm->objects;
+    while (current != NULL) {
+        Object* next = current->next;
+        if (current->is_marked) {
+            current->is_marked = false;
+            previous = current;
+            current  = next;
             continue;
-        }
-        if (object.prev == NULL) M_vm->objects = object.curr->next;
-        else object.prev->next = object.curr->next;
-        
-        Object_free(object.curr);
+        } 
+
+        if (previous == NULL) M_vm->objects = next;
+        else previous->next = next;
+
+        Object_free(current);
+        current = next;
     }
-    //
-    // OR 
-    //
-    // Object *previous = NULL;
-    // LinkedList_foreach(Object, M_vm->objects, object) {
-    //     Object* current = object.curr;
-    //     if (current->is_marked) {
-    //         previous = current;
-    //         continue;
-    //     } 
-    //
-    //     if (previous == NULL) M_vm->objects = current->next;
-    //     else previous->next = current->next;
-    // }
 }
 
 static void Memory_mark_values_gray(ArrayValue *values) {
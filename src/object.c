@@ -9,6 +9,7 @@ Object* Object_allocate(ObjectKind kind, size_t size, Object** object_head) {
     
     object->kind      = kind;
     object->is_marked = false;
+    object->is_permanent = false;
     if (object_head != NULL) LinkedList_push(*object_head, object);
 
 #ifdef DEBUG_GC_TRACE
@@ -76,6 +77,9 @@ ObjectFunction* ObjectFunction_allocate(Object** object_head) {
     object_fn->arity = 0;
     object_fn->name = NULL;
     object_fn->outsiders_count = 0;
+    object_fn->max_stack_depth = 0;
+    object_fn->has_captured_locals = false;
+    object_fn->closure_shared = NULL;
     Bytecode_init(&object_fn->bytecode);
 
     return object_fn;
@@ -93,22 +97,12 @@ ObjectValue* ObjectValue_allocate(Object** object_head, Value* value_address) {
 
 ObjectClosure* ObjectClosure_allocate(ObjectFunction* function, Object** object_head) {
     int item_count = function->outsiders_count;
-    ObjectValue** items = NULL;
-    if (item_count > 0) {
-       items = Memory_Allocate_Count(ObjectValue*, item_count);
-       assert(items);
-       for (int i = 0; i < item_count; i++) items[i] = NULL;
-    }
-    
-    Memory_transaction_push(value_make_object(items));
-//  {
-    ObjectClosure* closure = Object_Allocate(ObjectClosure, ObjectKind_Closure, object_head);
+    size_t size = sizeof(ObjectClosure) + sizeof(ObjectValue*) * item_count;
+    ObjectClosure* closure = (ObjectClosure*)Object_allocate(ObjectKind_Closure, size, object_head);
     assert(closure);
     closure->function = function;
-    closure->heap_values.items = items;
-    closure->heap_values.count = item_count;
-//  }
-    Memory_transaction_pop();
+    closure->heap_values_count = item_count;
+    for (int i = 0; i < item_count; i++) closure->heap_values[i] = NULL;
 
     return closure;
 }
@@ -137,6 +131,7 @@ ObjectInstance* ObjectInstance_allocate(ObjectClass *klass, Object** object_head
     assert(instance);
     instance->klass = klass;
     hash_table_init(&instance->fields);
+    hash_table_init(&instance->methods_bound);
 
     return instance;
 }
@@ -240,8 +235,7 @@ void Object_free(Object* object) {
         //       ObjectValue or ObjectFunction instance.
         //
         ObjectClosure* object_cl = (ObjectClosure*)object;
-        Memory_FreeArray(ObjectValue*, object_cl->heap_values.items, object_cl->heap_values.count);
-        Memory_Free(ObjectClosure, object);
+        Memory_allocate(object, sizeof(ObjectClosure) + sizeof(ObjectValue*) * object_cl->heap_values_count, 0);
         object = NULL;
     } break;
     case ObjectKind_Function_Native: {
@@ -257,6 +251,7 @@ void Object_free(Object* object) {
     case ObjectKind_Instance: {
         ObjectInstance* instance = (ObjectInstance*)object;
         hash_table_free(&instance->fields);
+        hash_table_free(&instance->methods_bound);
         Memory_Free(ObjectInstance, instance);
     } break;
     case ObjectKind_Method: {
@@ -29,13 +29,16 @@ static ObjectFunction* parser_parse_function_paramenters_and_body(Parser* parser
 static Statement* parser_parse_statement_expression(Parser* parser); // TODO: rename to ???
 static Expression* parser_parse_expression(Parser* parser, OperatorPrecedence operator_precedence_previous);
 static Expression* parser_parse_literals(Parser* parser, bool can_assign);
-static Expression* parser_parse_operator_function_call(Parser* parser, Expression* left_operand);
+static Expression* parser_parse_operator_function_call(Parser* parser, Expression* left_operand, OperandStart left_start);
 static Expression* parser_parse_operator_object_getter_and_setter(Parser* parser, Expression* left_expression, bool can_assign);
 static void parser_parse_operator_assignment(Parser* parser, int identifier_location, int identifier_location_index);
 static Expression* parser_parse_operators_unary(Parser* parser);
 static Expression* parser_parse_operators_logical(Parser* parser, Expression* left_operand);
-static Expression* parser_parse_operators_arithmetic(Parser* parser, Expression* left_operand);
-static Expression* parser_parse_operators_relational(Parser* parser, Expression* left_operand);
+static Expression* parser_parse_operators_arithmetic(Parser* parser, Expression* left_operand, OperandStart left_start);
+static Expression* parser_parse_operators_relational(Parser* parser, Expression* left_operand, OperandStart left_start);
+static OperandStart parser_get_operand_start(Parser* parser);
+static void parser_compile_operator_unary(Parser* parser, OpCode opcode, OperandStart operand_start, int line_number);
+static void parser_compile_operator_binary(Parser* parser, OpCode opcode, OperandStart left_start, OperandStart right_start, int line_number);
 static uint8_t parser_parse_arguments(Parser* parser, TokenKind token_kind);
 // TODO: rename to Function_find_local_by_token(Function* function, Token* name, Local** out);
 static void parser_compile_return(Parser* parser);
@@ -51,6 +54,13 @@ static void parser_end_parsing(Parser* parser);
 static void parser_begin_scope(Parser* parser);
 static void parser_end_scope(Parser* parser);
 
+static Statement* parser_allocate_statement(Parser* parser, Statement statement);
+static Expression* parser_allocate_expression(Parser* parser, Expression expression);
+static ArrayStatement* parser_allocate_array_statement(Parser* parser);
+static void parser_insert_statement(Parser* parser, ArrayStatement* statements, Statement statement);
+
+static Function* parser_allocate_function(Parser* parser);
+static void parser_release_function(Parser* parser, Function* function);
 static void parser_init_function(Parser* parser, Function* function, FunctionKind function_kind, Token class_name);
 static ObjectFunction* parser_end_function(Parser* parser, Function* function);
 
@@ -59,6 +69,9 @@ void parser_init(Parser* parser, const char* source_code, ParserInitParams param
     parser->token_previous = (Token){ 0 }; // token_error
     parser->panic_mode = false;
     parser->had_error = false;
+    parser->is_building_ast = false;
+    parser->is_optimizing = !params.is_optimizer_disabled;
+    Arena_init(&parser->arena);
     parser->lexer = params.lexer;
     if (params.lexer == NULL) {
         parser->lexer = lexer_create_static();
@@ -66,10 +79,12 @@ void parser_init(Parser* parser, const char* source_code, ParserInitParams param
         lexer_init(parser->lexer, source_code);
     }
     parser->function = NULL;
+    parser->functions_free = NULL;
     parser->first_class_declaration = NULL;
     parser->interpolation_count_nesting = 0;
     parser->interpolation_count_value_pushed = 0;
     parser->continue_jump_to = -1;
+    parser->continue_scope_depth = 0;
 
     hash_table_init(&parser->table_strings);
     parser->string_database = params.string_database;
@@ -85,19 +100,25 @@ void parser_init(Parser* parser, const char* source_code, ParserInitParams param
     StackBreak_init(&parser->breakpoints);
     StackBlock_init(&parser->blocks);
 
-    Memory_register(NULL, NULL, parser);
-
     parser->debugger_execution_pause  = false;
     parser->debugger_execution_resume = false;
     parser->debugger_functions = (DArrayFunction) {0};
 }
 
+// NOTE: The AST is only built when 'return_statements' isn't NULL, otherwise
+//       the parse functions emit the bytecode and return NULL nodes.
+//
 ObjectFunction* parser_parse(Parser* parser, ArrayStatement** return_statements, HashTable* string_database, Object** object_head) {
-    Function function;
-    ArrayStatement* statements = array_statement_allocate();
+    parser->is_building_ast = return_statements != NULL;
+    ArrayStatement* statements = parser_allocate_array_statement(parser);
+    Function* function = parser_allocate_function(parser);
 
+    // NOTE: No collection runs while compiling, and what the compiler
+    //       allocated is never collected, see 'Memory_begin_compilation'.
+    //
+    Memory_begin_compilation();
     parser_advance(parser);
-    parser_init_function(parser, &function, FunctionKind_Script, (Token){0});
+    parser_init_function(parser, function, FunctionKind_Script, (Token){0});
 
     for (;;) {
         if (parser->token_current.kind == Token_Eof) break;
@@ -105,11 +126,12 @@ ObjectFunction* parser_parse(Parser* parser, ArrayStatement** return_statements,
         Statement* statement = parser_parse_statement(parser, BlockType_Clean);
         if (statement == NULL) continue;
 
-        array_statement_insert(statements, *statement);
-        // TODO: free statement here
+        parser_insert_statement(parser, statements, *statement);
     }
 
-    ObjectFunction* compiled_script = parser_end_function(parser, &function);
+    ObjectFunction* compiled_script = parser_end_function(parser, function);
+    parser_release_function(parser, function);
+    Memory_end_compilation(parser->object_head);
 
     if (return_statements != NULL) *return_statements =  statements;
     if (string_database   != NULL) *string_database   = *parser->string_database;
@@ -544,7 +566,49 @@ static Bytecode* parser_get_current_bytecode(Parser* parser) {
     return &parser->function->object->bytecode;
 }
 
+// NOTE: The AST nodes live in 'parser->arena', they are released by
+//       'Parser_free', not by 'statement_free'/'expression_free'.
+//
+static Statement* parser_allocate_statement(Parser* parser, Statement statement) {
+    if (!parser->is_building_ast) return NULL;
+
+    Statement* result = Arena_Allocate(&parser->arena, Statement);
+    *result = statement;
+    return result;
+}
+
+static Expression* parser_allocate_expression(Parser* parser, Expression expression) {
+    if (!parser->is_building_ast) return NULL;
+
+    Expression* result = Arena_Allocate(&parser->arena, Expression);
+    *result = expression;
+    return result;
+}
+
+static ArrayStatement* parser_allocate_array_statement(Parser* parser) {
+    if (!parser->is_building_ast) return NULL;
+    return Arena_Allocate(&parser->arena, ArrayStatement);
+}
+
+static void parser_insert_statement(Parser* parser, ArrayStatement* statements, Statement statement) {
+    if (statements->capacity < statements->count + 1) {
+        uint32_t capacity_old = statements->capacity;
+        statements->capacity = capacity_old < 8 ? 8 : 2 * capacity_old;
+        statements->items = (Statement*)Arena_reallocate(
+            &parser->arena,
+            statements->items,
+            sizeof(Statement) * capacity_old,
+            sizeof(Statement) * statements->capacity
+        );
+    }
+
+    statements->items[statements->count] = statement;
+    statements->count += 1;
+}
+
 static void Parser_debug_print_expression(Lexer lexer, const char* start) {
+    if (!DEBUG_TRACE_INSTRUCTION) return;
+
     bool syntax_error = true;
     
     Token token = lexer_scan(&lexer);
@@ -573,6 +637,8 @@ static void Parser_debug_print_expression(Lexer lexer, const char* start) {
 }
 
 static void Parser_debug_print_declaration(Lexer lexer, const char* start) {
+    if (!DEBUG_TRACE_INSTRUCTION) return;
+
     int count_brackets = 0;
     
     Token token = lexer_scan(&lexer);
@@ -606,6 +672,8 @@ static void Parser_debug_print_declaration(Lexer lexer, const char* start) {
 }
 
 static void Parser_debug_print_function(Lexer lexer, const char* start) {
+    if (!DEBUG_TRACE_INSTRUCTION) return;
+
     int count_brackets = 0;
     
     Token token = lexer_scan(&lexer);
@@ -735,7 +803,7 @@ static Statement* parser_parse_statement_expression(Parser* parser) {
         .expression = expression
     };
 
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static Statement* parser_parse_instruction_print(Parser* parser) {
@@ -765,11 +833,30 @@ static Statement* parser_parse_instruction_print(Parser* parser) {
     statement.kind = StatementKind_Print;
     statement.print = expression;
 
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static void parser_begin_block(Parser* parser, BlockType block_type) {
     StackBlock_push(&parser->blocks, block_type);
+    parser->blocks.scope_depths[StackBlock_get_top_item_index(&parser->blocks)] = parser->function->depth;
+}
+
+// Emits the pops for the locals deeper than 'scope_depth', without taking
+// them out of scope. 'sai' and 'salta' jump over the end of those scopes and
+// the Stack has to be the same on every path that gets to the jump target.
+//
+static void parser_pop_locals_above(Parser* parser, int scope_depth) {
+    StackLocal* locals = &parser->function->locals;
+    for (int i = locals->top - 1; i >= 0; i--) {
+        Local* local = &locals->items[i];
+        if (local->scope_depth <= scope_depth) break;
+
+        Compiler_CompileInstruction_1Byte(
+            parser_get_current_bytecode(parser),
+            local->action == LocalAction_Move_Heap ? OpCode_Stack_Move_Value_To_Heap : OpCode_Stack_Pop,
+            parser->token_previous.line_number
+        );
+    }
 }
 
 static void parser_end_block(Parser* parser, BlockType block_type) {
@@ -798,7 +885,7 @@ static Statement* parser_parse_instruction_block(Parser* parser, BlockType block
     parser_begin_scope(parser);
     if (block_type == BlockType_Clean) parser_begin_block(parser, block_type);
 
-    ArrayStatement* bloco = array_statement_allocate();
+    ArrayStatement* bloco = parser_allocate_array_statement(parser);
 
     for (;;) {
         TokenKind kind = parser->token_current.kind;
@@ -810,8 +897,7 @@ static Statement* parser_parse_instruction_block(Parser* parser, BlockType block
 
 //      TODO: Add Parser_read_commands();
 
-        array_statement_insert(bloco, *statement);
-//      TODO: free statement
+        parser_insert_statement(parser, bloco, *statement);
     }
 
     parser_consume(parser, Token_Right_Brace, "Expect '}' after block.");
@@ -823,7 +909,7 @@ static Statement* parser_parse_instruction_block(Parser* parser, BlockType block
     Statement statement = { 0 };
     statement.kind = StatementKind_Block;
     statement.bloco = bloco;
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 // if (condition) {then-block} sinou {else-block} 
@@ -878,7 +964,7 @@ static Statement* parser_parse_instruction_if(Parser* parser) {
     bool error = Compiler_PatchInstructionJump(parser_get_current_bytecode(parser), jump_operand_index);
     if (error) parser_error(parser, &parser->token_previous, "Too much code to jump over.");
 
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static Statement* parser_instruction_while(Parser* parser) {
@@ -896,7 +982,8 @@ static Statement* parser_instruction_while(Parser* parser) {
 
     Statement* body = parser_parse_statement(parser, false);
 
-    Compiler_CompileInstruction_Loop(parser_get_current_bytecode(parser), loop_start, parser->token_previous.line_number);
+    bool loop_error = Compiler_CompileInstruction_Loop(parser_get_current_bytecode(parser), loop_start, parser->token_previous.line_number);
+    if (loop_error) parser_error(parser, &parser->token_previous, "Loop body too large.");
     Compiler_PatchInstructionJump(parser_get_current_bytecode(parser), jump_if_false_operand_index);
     Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Stack_Pop, parser->token_previous.line_number);
 
@@ -906,7 +993,7 @@ static Statement* parser_instruction_while(Parser* parser) {
     statement.kind = StatementKind_Timenti;
     statement.timenti.condition = condition;
     statement.timenti.body = body;
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static Statement* parser_instruction_for(Parser* parser) {
@@ -916,11 +1003,11 @@ static Statement* parser_instruction_for(Parser* parser) {
 
     parser_consume(parser, Token_Left_Parenthesis, "Expected '(' after 'pa'.");
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("------ FOR-LOOP Instruction ------\n");
 #endif
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("------ Initialization ------\n");
 #endif
 
@@ -945,7 +1032,7 @@ static Statement* parser_instruction_for(Parser* parser) {
         initializer = parser_parse_statement_expression(parser);
     }
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("--------------------------\n");
 #endif
 
@@ -953,7 +1040,7 @@ static Statement* parser_instruction_for(Parser* parser) {
     int exit_jump_operand_index = -1;
     Expression* condition = NULL;
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("------ Conditional ------\n");
 #endif
 
@@ -973,15 +1060,16 @@ static Statement* parser_instruction_for(Parser* parser) {
         );
     }
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("--------------------------\n");
 #endif
 
     Expression* increment = NULL;
     int increment_start_index = -1;
     int continue_jump_to_old = parser->continue_jump_to;
+    int continue_scope_depth_old = parser->continue_scope_depth;
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("------ Update ------\n");
 #endif
 
@@ -994,6 +1082,7 @@ static Statement* parser_instruction_for(Parser* parser) {
 
         increment_start_index = parser_get_current_bytecode(parser)->instructions.count;
         parser->continue_jump_to = increment_start_index;
+        parser->continue_scope_depth = parser->function->depth;
         increment = parser_parse_expression(parser, OperatorPrecedence_Assignment);
 
         Compiler_CompileInstruction_1Byte(
@@ -1004,18 +1093,19 @@ static Statement* parser_instruction_for(Parser* parser) {
 
         parser_consume(parser, Token_Right_Parenthesis, "Epected ')' after increment expression clause.");
 
-        Compiler_CompileInstruction_Loop(
+        bool loop_error = Compiler_CompileInstruction_Loop(
             parser_get_current_bytecode(parser),
             condition_start_index,
             parser->token_previous.line_number
         );
+        if (loop_error) parser_error(parser, &parser->token_previous, "Loop body too large.");
         Compiler_PatchInstructionJump(
             parser_get_current_bytecode(parser),
             jump_to_body
         );
     }
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("--------------------------\n");
 #endif
 
@@ -1030,10 +1120,10 @@ static Statement* parser_instruction_for(Parser* parser) {
         // 5. End the scope
         // 
         parser_begin_scope(parser);
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Copy_From_idx_To_Top, // Read Iniitialized Variable
-            (uint8_t)variable_stack_idx,
+            variable_stack_idx,
             parser->token_previous.line_number
         );
 
@@ -1050,25 +1140,25 @@ static Statement* parser_instruction_for(Parser* parser) {
     }
     // 1: }
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("------ Body ------\n");
 #endif
 
     Statement* body = parser_parse_statement(parser, BlockType_Loop);
 
-#ifdef DEBUG_TRACE_INSTRUCTION
+#if DEBUG_TRACE_INSTRUCTION
     printf("--------------------------\n");
 #endif
 
     // 1: {
     if (variable_stack_idx != -1) {
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Copy_From_idx_To_Top,
             new_variable_idx,
             parser->token_previous.line_number
         );
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Copy_Top_To_Idx,
             variable_stack_idx,
@@ -1088,11 +1178,12 @@ static Statement* parser_instruction_for(Parser* parser) {
     // 1: }
 
 
-    Compiler_CompileInstruction_Loop(
+    bool loop_error = Compiler_CompileInstruction_Loop(
         parser_get_current_bytecode(parser),
         increment_start_index,
         parser->token_previous.line_number
     );
+    if (loop_error) parser_error(parser, &parser->token_previous, "Loop body too large.");
 
     if (exit_jump_operand_index != -1) {
         Compiler_PatchInstructionJump(
@@ -1107,6 +1198,7 @@ static Statement* parser_instruction_for(Parser* parser) {
     }
 
     parser->continue_jump_to = continue_jump_to_old;
+    parser->continue_scope_depth = continue_scope_depth_old;
     parser_end_block(parser, BlockType_Loop);
     parser_end_scope(parser);
 
@@ -1116,7 +1208,7 @@ static Statement* parser_instruction_for(Parser* parser) {
     statement.pa.condition = condition;
     statement.pa.increment = increment;
     statement.pa.body = body;
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static Statement* parser_instruction_break(Parser* parser) {
@@ -1130,6 +1222,9 @@ static Statement* parser_instruction_break(Parser* parser) {
         return NULL;
     }
 
+    int block_index = StackBlock_get_top_item_index(&parser->blocks);
+    parser_pop_locals_above(parser, parser->blocks.scope_depths[block_index]);
+
     Breakpoint breakpoint = { 0 };
     breakpoint.operand_index = Compiler_CompileInstruction_Jump(parser_get_current_bytecode(parser), OpCode_Jump, parser->token_previous.line_number);
     breakpoint.block_depth = StackBlock_get_top_item_index(&parser->blocks);
@@ -1139,7 +1234,7 @@ static Statement* parser_instruction_break(Parser* parser) {
 
     Statement statement = { 0 };
     statement.kind = StatementKind_Sai;
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 // TODO: parser_parse_intruction_debugger_break(PARSER|RUNTIME|BOTH);
@@ -1161,7 +1256,7 @@ static Statement* parser_parse_instruction_debug(Parser* parser) {
 
     Statement statement = { 0 };
     statement.kind = StatementKind_Sai;
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static Statement* parser_instruction_continue(Parser* parser) {
@@ -1170,22 +1265,24 @@ static Statement* parser_instruction_continue(Parser* parser) {
         return NULL;
     }
 
-    Compiler_CompileInstruction_Loop(
+    parser_pop_locals_above(parser, parser->continue_scope_depth);
+    bool loop_error = Compiler_CompileInstruction_Loop(
         parser_get_current_bytecode(parser),
         parser->continue_jump_to,
         parser->token_previous.line_number
     );
+    if (loop_error) parser_error(parser, &parser->token_previous, "Loop body too large.");
 
     parser_consume(parser, Token_Semicolon, "Expected ';' after token 'salta'.");
 
     Statement statement = { 0 };
     statement.kind = StatementKind_Salta;
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static void parser_compile_return(Parser* parser) {
     if (parser->function->function_kind == FunctionKind_Method_Initializer) {
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Copy_From_idx_To_Top,
             0,
@@ -1219,6 +1316,26 @@ static Statement* parser_instruction_return(Parser* parser) {
 
         Expression* expression = parser_parse_expression(parser, OperatorPrecedence_Assignment);
         parser_consume(parser, Token_Semicolon, "Expect ';' after expression.");
+
+        // NOTE: 'divolvi f(...)', 'divolvi o.f(...)', 'divolvi Super.f(...)':
+        //       the call is the last instruction of the expression, it
+        //       becomes a tail call. The 'Return' stays after it, for the
+        //       callees that aren't Closures and for the jumps of 'e' and
+        //       'ou' that land on it.
+        //
+        Bytecode* bytecode = parser_get_current_bytecode(parser);
+        int call_offset = parser->function->call_offset_last;
+        if (call_offset != -1 && call_offset < bytecode->instructions.count) {
+            uint8_t* call = &bytecode->instructions.items[call_offset];
+            OpCode call_tail = 0;
+            if      (*call == OpCode_Call_Function)     call_tail = OpCode_Call_Function_Tail;
+            else if (*call == OpCode_Call_Method)       call_tail = OpCode_Call_Method_Tail;
+            else if (*call == OpCode_Call_Super_Method) call_tail = OpCode_Call_Super_Method_Tail;
+
+            if (call_tail && call_offset + Bytecode_get_instruction_size(bytecode, call_offset) == bytecode->instructions.count)
+                *call = call_tail;
+        }
+
         Compiler_CompileInstruction_1Byte(
             parser_get_current_bytecode(parser),
             OpCode_Return,
@@ -1228,7 +1345,7 @@ static Statement* parser_instruction_return(Parser* parser) {
 
     Statement statement = { 0 };
     statement.kind = StatementKind_Return;
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static ObjectString* parser_intern_token(Token token, Object** object_head, HashTable* string_database) {
@@ -1252,11 +1369,7 @@ static ObjectString* parser_intern_token(Token token, Object** object_head, Hash
 
 static int parser_save_identifier_into_bytecode(Bytecode* bytecode, ObjectString* identifier) {
     Value value_string = value_make_object_string(identifier);
-    Memory_transaction_push(value_string);
-// {
-    int value_index = ArrayValue_insert(&bytecode->values, value_string);
-// }
-    Memory_transaction_pop();
+    int value_index = Bytecode_insert_value(bytecode, value_string);
     
     if (value_index > UINT8_MAX) 
         return -1; 
@@ -1298,7 +1411,7 @@ static int parser_find_identifier_location(Parser* parser, Token token, int* out
 static void Parser_compile_variable_value_to_stack(Parser* parser, int identifier_location, int identifier_location_index) {
     if (identifier_location == 1) {
 //      Its a Local Variable
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Copy_From_idx_To_Top,
             identifier_location_index,
@@ -1306,7 +1419,7 @@ static void Parser_compile_variable_value_to_stack(Parser* parser, int identifie
         );
     } else if (identifier_location == 2) {
 //      Its a Closure Variable
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Copy_From_Heap_To_Top,
             identifier_location_index,
@@ -1328,7 +1441,7 @@ static void parser_parse_operator_assignment(Parser* parser, int identifier_loca
 
     if (identifier_location == 1) {
 //      Its a Local Variable
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Copy_Top_To_Idx,
             identifier_location_index,
@@ -1336,7 +1449,7 @@ static void parser_parse_operator_assignment(Parser* parser, int identifier_loca
         );
     } else if (identifier_location == 2) {
 //      Its a Closure Variable
-        Compiler_CompileInstruction_2Bytes(
+        Compiler_CompileInstruction_Index(
             parser_get_current_bytecode(parser),
             OpCode_Stack_Move_Top_To_Heap,
             identifier_location_index,
@@ -1425,13 +1538,13 @@ static Statement* parser_parse_declaration_class(Parser* parser) {
         parser_initialize_local_identifier(parser);
     }
 
-    ClassDeclaration new_class = {0};
-    new_class.name = class_name;
-    LinkedList_push(parser->first_class_declaration, &new_class);
+    ClassDeclaration* new_class = Arena_Allocate(&parser->arena, ClassDeclaration);
+    new_class->name = class_name;
+    LinkedList_push(parser->first_class_declaration, new_class);
 
     if (parser_match_then_advance(parser, Token_Less)) {
         parser_consume(parser, Token_Identifier, "Expect Superclass name.");
-        new_class.has_superclass = true;
+        new_class->has_superclass = true;
 
 //      { 
         parser_load_variable_value_to_stack(parser, parser->token_previous);
@@ -1509,7 +1622,7 @@ static Statement* parser_parse_declaration_class(Parser* parser) {
         parser->token_previous.line_number
     );
 
-    if (new_class.has_superclass) {
+    if (new_class->has_superclass) {
         parser_end_scope(parser);
     }
 
@@ -1568,7 +1681,7 @@ static Statement* parser_parse_declaration_function(Parser* parser) {
         );
     }
 
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static Statement* parser_parse_method_declaration(Parser* parser) {
@@ -1576,9 +1689,9 @@ static Statement* parser_parse_method_declaration(Parser* parser) {
 }
 
 static ObjectFunction* parser_parse_function_paramenters_and_body(Parser* parser, FunctionKind function_kind, Token class_name) {
-    Function function;
+    Function* function = parser_allocate_function(parser);
     Token function_name = parser->token_previous;
-    parser_init_function(parser, &function, function_kind, class_name);
+    parser_init_function(parser, function, function_kind, class_name);
 
 //  NOTE: Parsing function doesnt explecitly close the Scope 'parser_end_scope()', because
 //        the 'Parser_end_function' will emit the Return instruction which at runtime will
@@ -1628,7 +1741,7 @@ static ObjectFunction* parser_parse_function_paramenters_and_body(Parser* parser
     Statement* statement_block = parser_parse_instruction_block(parser, BlockType_Function);
 
     Bytecode_debug_print("------ Ending function '%.*s()' -------\n", function_name.length, function_name.start);
-    ObjectFunction* object_fn = parser_end_function(parser, &function);
+    ObjectFunction* object_fn = parser_end_function(parser, function);
 
     if (!parser->debugger_execution_resume && parser->debugger_execution_pause) {
         char *error_msg = NULL;
@@ -1636,16 +1749,13 @@ static ObjectFunction* parser_parse_function_paramenters_and_body(Parser* parser
         if (!ok) printf("[ERROR] %s\n", error_msg);
     }
     
-    Memory_transaction_push(value_make_object(object_fn));
-    {
-        Compiler_CompileInstruction_Closure(
-            parser_get_current_bytecode(parser),
-            value_make_object(object_fn),
-            &function.outsiders,
-            parser->token_previous.line_number
-        );
-    } 
-    Memory_transaction_pop();
+    Compiler_CompileInstruction_Closure(
+        parser_get_current_bytecode(parser),
+        value_make_object(object_fn),
+        &function->outsiders,
+        parser->token_previous.line_number
+    );
+    parser_release_function(parser, function);
     
     return object_fn;
 }
@@ -1673,7 +1783,7 @@ static Statement* parser_parse_declaration_variable(Parser* parser) {
 
         if (parser_check_locals_duplicates(parser, &parser->token_previous)) {
             parser_error(parser, &parser->token_previous, "Already a variable with this name in this scope.");
-            return statement_allocate(statement);
+            return parser_allocate_statement(parser, statement);
         }
         
         StackLocal_push(&parser->function->locals, (Local) {
@@ -1708,7 +1818,7 @@ static Statement* parser_parse_declaration_variable(Parser* parser) {
                 parser->token_previous.line_number
             );
 
-            statement.variable_declaration.rhs = expression_allocate(expression_make_nil());
+            statement.variable_declaration.rhs = parser_allocate_expression(parser, expression_make_nil());
         }
 
         parser_consume(parser, Token_Semicolon, "Expected ';' after expression.");
@@ -1726,7 +1836,7 @@ static Statement* parser_parse_declaration_variable(Parser* parser) {
         Local* local = &parser->function->locals.items[parser->function->locals.top - 1];
         local->scope_depth = parser->function->depth;
 
-        return statement_allocate(statement);
+        return parser_allocate_statement(parser, statement);
     } while (0);
 
     //
@@ -1751,45 +1861,41 @@ static Statement* parser_parse_declaration_variable(Parser* parser) {
     );
 
     Value value_string = value_make_object_string(statement.variable_declaration.identifier);
-    Memory_transaction_push(value_string);
-    {
-        int value_index = Compiler_CompileValue(
-            parser_get_current_bytecode(parser), 
-            value_string
-        );
-
-        if (value_index > UINT8_MAX) {
-            parser_error(parser, &parser->token_current, "Too many constants.");
-            global_index = 0;
-        } else {
-            global_index = value_index;
-        }
-
-        // Check for assignment
-        // 
-        if (parser_match_then_advance(parser, Token_Equal)) {
-            statement.variable_declaration.rhs = parser_parse_expression(parser, OperatorPrecedence_Assignment);
-        } else {
-            Compiler_CompileInstruction_1Byte(
-                parser_get_current_bytecode(parser),
-                OpCode_Stack_Push_Literal_Nil,
-                parser->token_previous.line_number
-            );
-            statement.variable_declaration.rhs = expression_allocate(expression_make_nil());
-        }
+    int value_index = Compiler_CompileValue(
+        parser_get_current_bytecode(parser), 
+        value_string
+    );
 
-        parser_consume(parser, Token_Semicolon, "Expected ';' after expression.");
+    if (value_index > UINT8_MAX) {
+        parser_error(parser, &parser->token_current, "Too many constants.");
+        global_index = 0;
+    } else {
+        global_index = value_index;
+    }
 
-        // Define Global Varible
-        //
-        Compiler_CompileInstruction_2Bytes(
+    // Check for assignment
+    // 
+    if (parser_match_then_advance(parser, Token_Equal)) {
+        statement.variable_declaration.rhs = parser_parse_expression(parser, OperatorPrecedence_Assignment);
+    } else {
+        Compiler_CompileInstruction_1Byte(
             parser_get_current_bytecode(parser),
-            OpCode_Define_Global,
-            global_index,
+            OpCode_Stack_Push_Literal_Nil,
             parser->token_previous.line_number
         );
+        statement.variable_declaration.rhs = parser_allocate_expression(parser, expression_make_nil());
     }
-    Memory_transaction_pop();
+
+    parser_consume(parser, Token_Semicolon, "Expected ';' after expression.");
+
+    // Define Global Varible
+    //
+    Compiler_CompileInstruction_2Bytes(
+        parser_get_current_bytecode(parser),
+        OpCode_Define_Global,
+        global_index,
+        parser->token_previous.line_number
+    );
 
     // TODO: #ifdef DEBUG_SHOW_CODE
     // 
@@ -1799,7 +1905,7 @@ static Statement* parser_parse_declaration_variable(Parser* parser) {
         source_code
     );
 
-    return statement_allocate(statement);
+    return parser_allocate_statement(parser, statement);
 }
 
 static OperatorMetadata parser_get_operator_metadata(TokenKind kind)
@@ -1952,13 +2058,14 @@ static void parser_parse_superclass_method_call(Parser* parser) {
 //            then 'Parser_compile_variable_value_to_stack(parser, identifier_location, identifier_location_index);'
         parser_load_variable_value_to_stack(parser, superclass);
 
-        Compiler_CompileInstruction_3Bytes(
+        int operand_index = Compiler_CompileInstruction_3Bytes(
             parser_get_current_bytecode(parser),
             OpCode_Call_Super_Method,
             method_location_index,
             argument_count,
             parser->token_previous.line_number
         );
+        parser->function->call_offset_last = operand_index - 2;
     }
     else {
         parser_load_variable_value_to_stack(parser, superclass);
@@ -1977,6 +2084,7 @@ static void parser_parse_superclass_method_call(Parser* parser) {
 }
 
 static Expression* parser_parse_expression(Parser* parser, OperatorPrecedence operator_precedence_previous) {
+    OperandStart operand_start = parser_get_operand_start(parser);
     parser_advance(parser);
 
     bool can_assign               = (operator_precedence_previous <= OperatorPrecedence_Assignment);
@@ -2088,19 +2196,19 @@ static Expression* parser_parse_expression(Parser* parser, OperatorPrecedence op
         parser_advance(parser);
 
         if (parser_is_operator_arithmetic(parser->token_previous)) {
-            expression = parser_parse_operators_arithmetic(parser, expression);
+            expression = parser_parse_operators_arithmetic(parser, expression, operand_start);
         } 
         else if (parser_is_operator_logical(parser->token_previous)) {
             expression = parser_parse_operators_logical(parser, expression);
         } 
         else if (parser_is_operator_relational(parser->token_previous)) {
-            expression = parser_parse_operators_relational(parser, expression);
+            expression = parser_parse_operators_relational(parser, expression, operand_start);
         } 
         else if (parser->token_previous.kind == Token_Left_Parenthesis) {
-            expression = parser_parse_operator_function_call(parser, expression);
+            expression = parser_parse_operator_function_call(parser, expression, operand_start);
         } 
         else if (parser->token_previous.kind == Token_Left_Brace) {
-            expression = parser_parse_operator_function_call(parser, expression);
+            expression = parser_parse_operator_function_call(parser, expression, operand_start);
         }
         else if (parser->token_previous.kind == Token_Dot) {
             expression = parser_parse_operator_object_getter_and_setter(parser, expression, can_assign);
@@ -2140,7 +2248,7 @@ static Expression* parser_parse_literals(Parser* parser, bool can_assign) {
             parser->token_previous.line_number
         );
 
-        return expression_allocate(e_number);
+        return parser_allocate_expression(parser, e_number);
     }
 
     if (parser->token_previous.kind == Token_Verdadi) {
@@ -2152,7 +2260,7 @@ static Expression* parser_parse_literals(Parser* parser, bool can_assign) {
             parser->token_previous.line_number
         );
 
-        return expression_allocate(e_true);
+        return parser_allocate_expression(parser, e_true);
     }
 
     if (parser->token_previous.kind == Token_Falsu) {
@@ -2164,7 +2272,7 @@ static Expression* parser_parse_literals(Parser* parser, bool can_assign) {
             parser->token_previous.line_number
         );
 
-        return expression_allocate(e_false);
+        return parser_allocate_expression(parser, e_false);
     }
 
     if (parser->token_previous.kind == Token_Nulo) {
@@ -2176,7 +2284,7 @@ static Expression* parser_parse_literals(Parser* parser, bool can_assign) {
             parser->token_previous.line_number
         );
 
-        return expression_allocate(nil);
+        return parser_allocate_expression(parser, nil);
     }
 
     if (parser->token_previous.kind == Token_String) {
@@ -2184,18 +2292,14 @@ static Expression* parser_parse_literals(Parser* parser, bool can_assign) {
         parser->token_previous.length -= 2;
         ObjectString* string = parser_intern_token(parser->token_previous, parser->object_head, parser->string_database);
         Value v_string = value_make_object(string);
-        Memory_transaction_push(v_string);
-        {
-            Compiler_CompileInstruction_Constant(
-                parser_get_current_bytecode(parser),
-                v_string,
-                parser->token_previous.line_number
-            );
-        }
-        Memory_transaction_pop();
+        Compiler_CompileInstruction_Constant(
+            parser_get_current_bytecode(parser),
+            v_string,
+            parser->token_previous.line_number
+        );
 
         Expression e_string = expression_make_string(string);
-        return expression_allocate(e_string);
+        return parser_allocate_expression(parser, e_string);
     }
 
     if (parser->token_previous.kind == Token_String_Interpolation) {
@@ -2206,15 +2310,11 @@ static Expression* parser_parse_literals(Parser* parser, bool can_assign) {
 
             ObjectString* string = parser_intern_token(parser->token_previous, parser->object_head, parser->string_database);
             Value v_string = value_make_object(string);
-            Memory_transaction_push(v_string);
-            {
-                Compiler_CompileInstruction_Constant(
-                    parser_get_current_bytecode(parser),
-                    v_string,
-                    parser->token_previous.line_number
-                );
-            }
-            Memory_transaction_pop();
+            Compiler_CompileInstruction_Constant(
+                parser_get_current_bytecode(parser),
+                v_string,
+                parser->token_previous.line_number
+            );
 
             parser->interpolation_count_value_pushed += 1;
             parser->interpolation_count_nesting += 1;
@@ -2254,30 +2354,34 @@ static Expression* parser_parse_literals(Parser* parser, bool can_assign) {
 }
 
 static Expression* parser_parse_operators_unary(Parser* parser) {
+    OperandStart operand_start = parser_get_operand_start(parser);
+
     if (parser->token_previous.kind == Token_Minus) {
         Expression* expression = parser_parse_expression(parser, OperatorPrecedence_Negate);
         Expression negation = expression_make_negation(expression);
 
-        Compiler_CompileInstruction_1Byte(
-            parser_get_current_bytecode(parser), 
+        parser_compile_operator_unary(
+            parser, 
             OpCode_Negation, 
+            operand_start, 
             parser->token_previous.line_number
         );
 
-        return expression_allocate(negation);
+        return parser_allocate_expression(parser, negation);
     }
 
     if (parser->token_previous.kind == Token_Ka) {
         Expression* expression = parser_parse_expression(parser, OperatorPrecedence_Not);
         Expression not = expression_make_not(expression);
 
-        Compiler_CompileInstruction_1Byte(
-            parser_get_current_bytecode(parser), 
+        parser_compile_operator_unary(
+            parser, 
             OpCode_Not, 
+            operand_start, 
             parser->token_previous.line_number
         );
 
-        return expression_allocate(not);
+        return parser_allocate_expression(parser, not);
     }
 
     if (parser->token_previous.kind == Token_Left_Parenthesis) {
@@ -2285,7 +2389,7 @@ static Expression* parser_parse_operators_unary(Parser* parser) {
         Expression grouping = expression_make_grouping(expression);
 
         parser_consume(parser, Token_Right_Parenthesis, "Expected ')' after expression.");
-        return expression_allocate(grouping);
+        return parser_allocate_expression(parser, grouping);
     }
 
     return NULL;
@@ -2361,7 +2465,7 @@ static Expression* parser_parse_operators_logical(Parser* parser, Expression* le
         Compiler_PatchInstructionJump(parser_get_current_bytecode(parser), operand_index);
 
         Expression expression_and = expression_make_and(left_operand, rigth_operand);
-        return expression_allocate(expression_and);
+        return parser_allocate_expression(parser, expression_and);
     } break;
     case Token_Ou: {
         int jump_if_false_operand_index = Compiler_CompileInstruction_Jump(parser_get_current_bytecode(parser), OpCode_Jump_If_False, parser->token_previous.line_number);
@@ -2374,43 +2478,44 @@ static Expression* parser_parse_operators_logical(Parser* parser, Expression* le
         Compiler_PatchInstructionJump(parser_get_current_bytecode(parser), jump_operand_index);
 
         Expression expression_or = expression_make_or(left_operand, rigth_operand);
-        return expression_allocate(expression_or);
+        return parser_allocate_expression(parser, expression_or);
     } break;
     }
 
 }
 
-static Expression* parser_parse_operators_arithmetic(Parser* parser, Expression* left_operand) {
+static Expression* parser_parse_operators_arithmetic(Parser* parser, Expression* left_operand, OperandStart left_start) {
     TokenKind operator_kind_previous = parser->token_previous.kind;
     OperatorMetadata operator_previous = parser_get_operator_metadata(operator_kind_previous);
+    OperandStart right_start = parser_get_operand_start(parser);
     Expression* right_operand = parser_parse_expression(parser, operator_previous.precedence);
 
     switch (operator_kind_previous)
     {
     case Token_Plus: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Add, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Add, left_start, right_start, parser->token_previous.line_number);
         Expression addition = expression_make_addition(left_operand, right_operand);
-        return expression_allocate(addition);
+        return parser_allocate_expression(parser, addition);
     } break;
     case Token_Minus: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Subtract, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Subtract, left_start, right_start, parser->token_previous.line_number);
         Expression subtraction = expression_make_subtraction(left_operand, right_operand);
-        return expression_allocate(subtraction);
+        return parser_allocate_expression(parser, subtraction);
     } break;
     case Token_Asterisk: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Multiply, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Multiply, left_start, right_start, parser->token_previous.line_number);
         Expression multiplication = expression_make_multiplication(left_operand, right_operand);
-        return expression_allocate(multiplication);
+        return parser_allocate_expression(parser, multiplication);
     } break;
     case Token_Slash: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Divide, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Divide, left_start, right_start, parser->token_previous.line_number);
         Expression division = expression_make_division(left_operand, right_operand);
-        return expression_allocate(division);
+        return parser_allocate_expression(parser, division);
     } break;
     case Token_Caret: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Exponentiation, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Exponentiation, left_start, right_start, parser->token_previous.line_number);
         Expression exponentiation = expression_make_exponentiation(left_operand, right_operand);
-        return expression_allocate(exponentiation);
+        return parser_allocate_expression(parser, exponentiation);
     } break;
     }
 
@@ -2418,57 +2523,58 @@ static Expression* parser_parse_operators_arithmetic(Parser* parser, Expression*
     return NULL;
 }
 
-static Expression* parser_parse_operators_relational(Parser* parser, Expression* left_operand) {
+static Expression* parser_parse_operators_relational(Parser* parser, Expression* left_operand, OperandStart left_start) {
     TokenKind operator_kind_previous = parser->token_previous.kind;
     OperatorMetadata operator_previous = parser_get_operator_metadata(operator_kind_previous);
+    OperandStart right_start = parser_get_operand_start(parser);
     Expression* right_operand = parser_parse_expression(parser, operator_previous.precedence);
 
     switch (operator_kind_previous)
     {
     case Token_Equal_Equal: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Equal_To, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Equal_To, left_start, right_start, parser->token_previous.line_number);
         Expression equal_to = expression_make_equal_to(left_operand, right_operand);
-        return expression_allocate(equal_to);
+        return parser_allocate_expression(parser, equal_to);
     } break;
     case Token_Not_Equal: {
         // a != b has the same semantics as !(a == b)
         //
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Equal_To, parser->token_previous.line_number);
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Not, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Equal_To, left_start, right_start, parser->token_previous.line_number);
+        parser_compile_operator_unary(parser, OpCode_Not, left_start, parser->token_previous.line_number);
 
-        Expression* equal_to = expression_allocate(expression_make_equal_to(left_operand, right_operand));
-        return expression_allocate(expression_make_not(equal_to));
+        Expression* equal_to = parser_allocate_expression(parser, expression_make_equal_to(left_operand, right_operand));
+        return parser_allocate_expression(parser, expression_make_not(equal_to));
     } break;
     case Token_Greater: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Greater_Than, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Greater_Than, left_start, right_start, parser->token_previous.line_number);
 
         Expression greater_than = expression_make_greater_than(left_operand, right_operand);
-        return expression_allocate(greater_than);
+        return parser_allocate_expression(parser, greater_than);
     } break;
     case Token_Greater_Equal: {
         // a >= b has the same semantics as !(a < b)
         //
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Less_Than, parser->token_previous.line_number);
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Not, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Less_Than, left_start, right_start, parser->token_previous.line_number);
+        parser_compile_operator_unary(parser, OpCode_Not, left_start, parser->token_previous.line_number);
 
-        Expression* greater_than = expression_allocate(expression_make_greater_than(left_operand, right_operand));
+        Expression* greater_than = parser_allocate_expression(parser, expression_make_greater_than(left_operand, right_operand));
         Expression greater_than_or_equal_to = expression_make_not(greater_than);
-        return expression_allocate(greater_than_or_equal_to);
+        return parser_allocate_expression(parser, greater_than_or_equal_to);
     } break;
     case Token_Less: {
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Less_Than, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Less_Than, left_start, right_start, parser->token_previous.line_number);
 
         Expression less_than = expression_make_less_than(left_operand, right_operand);
-        return expression_allocate(less_than);
+        return parser_allocate_expression(parser, less_than);
     } break;
     case Token_Less_Equal: {
         // a <= b has the same semantics as !(a > b)
         //
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Greater_Than, parser->token_previous.line_number);
-        Compiler_CompileInstruction_1Byte(parser_get_current_bytecode(parser), OpCode_Not, parser->token_previous.line_number);
+        parser_compile_operator_binary(parser, OpCode_Greater_Than, left_start, right_start, parser->token_previous.line_number);
+        parser_compile_operator_unary(parser, OpCode_Not, left_start, parser->token_previous.line_number);
 
         Expression less_than_or_equal_to = expression_make_less_than_or_equal_to(left_operand, right_operand);
-        return expression_allocate(less_than_or_equal_to);
+        return parser_allocate_expression(parser, less_than_or_equal_to);
     } break;
     }
 
@@ -2476,6 +2582,193 @@ static Expression* parser_parse_operators_relational(Parser* parser, Expression*
     return NULL;
 }
 
+// Constant Folding
+//
+// An operator whose operands each compiled to a single constant push is
+// evaluated here, and the pushes are replaced by the result. Operands the
+// Virtual Machine would reject ('1 + verdadi', '-"kaza"') are left alone,
+// so the error still happens at runtime, with the same message.
+//
+
+static OperandStart parser_get_operand_start(Parser* parser) {
+    Bytecode* bytecode = parser_get_current_bytecode(parser);
+
+    return (OperandStart) {
+        .instruction_offset = bytecode->instructions.count,
+        .values_count       = bytecode->values.count
+    };
+}
+
+// True if the code from 'operand_start' up to 'operand_end' is a single
+// instruction pushing a constant.
+//
+static bool parser_is_operand_constant(Parser* parser, OperandStart operand_start, int operand_end, Value* value_out) {
+    if (operand_start.instruction_offset >= operand_end) return false;
+
+    Bytecode* bytecode = parser_get_current_bytecode(parser);
+    int instruction_size = Bytecode_read_constant(bytecode, operand_start.instruction_offset, value_out);
+
+    return instruction_size != 0 && operand_start.instruction_offset + instruction_size == operand_end;
+}
+
+// True if the code from 'operand_start' up to 'operand_end' is a single
+// instruction loading a variable, which can be repeated without side effects.
+//
+static bool parser_is_operand_variable(Parser* parser, OperandStart operand_start, int operand_end) {
+    Bytecode* bytecode = parser_get_current_bytecode(parser);
+    if (operand_start.instruction_offset == operand_end) return false;
+    if (operand_start.instruction_offset + Bytecode_get_instruction_size(bytecode, operand_start.instruction_offset) != operand_end) return false;
+
+    uint8_t opcode = bytecode->instructions.items[operand_start.instruction_offset];
+    if (opcode == OpCode_Stack_Copy_From_idx_To_Top)       return true;
+    if (opcode == OpCode_Stack_Copy_From_idx_To_Top_Long)  return true;
+    if (opcode == OpCode_Stack_Copy_From_Heap_To_Top)      return true;
+    if (opcode == OpCode_Stack_Copy_From_Heap_To_Top_Long) return true;
+    if (opcode == OpCode_Read_Global)                      return true;
+
+    return false;
+}
+
+static ObjectString* parser_concatenate_strings(Parser* parser, ObjectString* a, ObjectString* b) {
+    String s_a          = string_make(a->characters, a->length);
+    String s_b          = string_make(b->characters, b->length);
+    String final        = string_concatenate(s_a, s_b);
+    uint32_t final_hash = string_hash(final);
+
+    ObjectString* object_string = hash_table_get_key(parser->string_database, final, final_hash);
+    if (object_string == NULL) {
+        object_string = ObjectString_Allocate(
+            .task   = AllocateTask_Initialize | AllocateTask_Intern,
+            .string = final,
+            .hash   = final_hash,
+            .first  = parser->object_head,
+            .table  = parser->string_database
+        );
+    } 
+    else {
+        string_free(&final);
+    }
+
+    return object_string;
+}
+
+// Same results as the Virtual Machine. Returns false for the operands it
+// would raise a runtime error on.
+//
+static bool parser_evaluate_operator(Parser* parser, OpCode opcode, Value a, Value b, Value* value_out) {
+    if (opcode == OpCode_Not) {
+        *value_out = value_make_boolean(value_negate_logically(a));
+        return true;
+    }
+
+    if (opcode == OpCode_Equal_To) {
+        *value_out = value_make_boolean(value_is_equal(a, b));
+        return true;
+    }
+
+    if (opcode == OpCode_Negation) {
+        if (!value_is_number(a)) return false;
+
+        *value_out = value_make_number(-value_as_number(a));
+        return true;
+    }
+
+    if (opcode == OpCode_Add && value_is_string(a) && value_is_string(b)) {
+        *value_out = value_make_object(parser_concatenate_strings(parser, value_as_string(a), value_as_string(b)));
+        return true;
+    }
+
+    if (!value_is_number(a) || !value_is_number(b)) return false;
+
+    double n_a = value_as_number(a);
+    double n_b = value_as_number(b);
+    switch (opcode)
+    {
+    default: return false;
+    case OpCode_Add:            *value_out = value_make_number(n_a + n_b);      break;
+    case OpCode_Subtract:       *value_out = value_make_number(n_a - n_b);      break;
+    case OpCode_Multiply:       *value_out = value_make_number(n_a * n_b);      break;
+    case OpCode_Divide:         *value_out = value_make_number(n_a / n_b);      break;
+    case OpCode_Exponentiation: *value_out = value_make_number(pow(n_a, n_b));  break;
+    case OpCode_Greater_Than:   *value_out = value_make_boolean(n_a > n_b);     break;
+    case OpCode_Less_Than:      *value_out = value_make_boolean(n_a < n_b);     break;
+    }
+
+    return true;
+}
+
+// Takes back the code from 'operand_start' on and pushes 'value' instead.
+//
+static void parser_replace_with_constant(Parser* parser, OperandStart operand_start, Value value) {
+    Bytecode* bytecode = parser_get_current_bytecode(parser);
+    int line_number = bytecode->lines.items[operand_start.instruction_offset];
+
+    Bytecode_truncate(bytecode, operand_start.instruction_offset, operand_start.values_count);
+
+    if (value_is_nil(value))
+        Compiler_CompileInstruction_1Byte(bytecode, OpCode_Stack_Push_Literal_Nil, line_number);
+    else if (value_is_boolean(value))
+        Compiler_CompileInstruction_1Byte(bytecode, value_as_boolean(value) ? OpCode_Stack_Push_Literal_True : OpCode_Stack_Push_Literal_False, line_number);
+    else
+        Compiler_CompileInstruction_Constant(bytecode, value, line_number);
+}
+
+static void parser_compile_operator_unary(Parser* parser, OpCode opcode, OperandStart operand_start, int line_number) {
+    Bytecode* bytecode = parser_get_current_bytecode(parser);
+
+    Value operand = { 0 };
+    Value result  = { 0 };
+    if (
+        parser_is_operand_constant(parser, operand_start, bytecode->instructions.count, &operand) &&
+        parser_evaluate_operator(parser, opcode, operand, value_make_nil(), &result)
+    ) {
+        parser_replace_with_constant(parser, operand_start, result);
+        return;
+    }
+
+    Compiler_CompileInstruction_1Byte(bytecode, opcode, line_number);
+}
+
+static void parser_compile_operator_binary(Parser* parser, OpCode opcode, OperandStart left_start, OperandStart right_start, int line_number) {
+    Bytecode* bytecode = parser_get_current_bytecode(parser);
+
+    Value left   = { 0 };
+    Value right  = { 0 };
+    Value result = { 0 };
+    bool is_right_constant = parser_is_operand_constant(parser, right_start, bytecode->instructions.count, &right);
+    if (
+        is_right_constant &&
+        parser_is_operand_constant(parser, left_start, right_start.instruction_offset, &left) &&
+        parser_evaluate_operator(parser, opcode, left, right, &result)
+    ) {
+        parser_replace_with_constant(parser, left_start, result);
+        return;
+    }
+
+    // NOTE: x ^ 2 -> x * x, loading the variable again instead of the 2.
+    //
+    if (
+        opcode == OpCode_Exponentiation &&
+        is_right_constant && value_is_number(right) && value_as_number(right) == 2 &&
+        parser_is_operand_variable(parser, left_start, right_start.instruction_offset)
+    ) {
+        uint8_t* load  = bytecode->instructions.items + left_start.instruction_offset;
+        int load_size  = right_start.instruction_offset - left_start.instruction_offset;
+        uint8_t load_opcode    = load[0];
+        uint8_t load_operand_1 = load[1];
+        uint8_t load_operand_2 = load_size == 3 ? load[2] : 0;
+
+        Bytecode_truncate(bytecode, right_start.instruction_offset, right_start.values_count);
+        if (load_size == 3)
+            Compiler_CompileInstruction_3Bytes(bytecode, load_opcode, load_operand_1, load_operand_2, line_number);
+        else
+            Compiler_CompileInstruction_2Bytes(bytecode, load_opcode, load_operand_1, line_number);
+        opcode = OpCode_Multiply;
+    }
+
+    Compiler_CompileInstruction_1Byte(bytecode, opcode, line_number);
+}
+
 // TODO: static uint8_t parser_parse_arguments(Parser* parser, TokenKind kind)
 static uint8_t parser_parse_arguments(Parser* parser, TokenKind token_kind) {
     uint8_t argument_count = 0;
@@ -2499,9 +2792,51 @@ static uint8_t parser_parse_arguments(Parser* parser, TokenKind token_kind) {
     return argument_count;
 }
 
-static Expression* parser_parse_operator_function_call(Parser* parser, Expression* left_operand) {
+// Takes back the 'OpCode_Object_Get_Property' that ends the callee, when
+// there is one, so '(o.f)(...)' is called as 'o.f(...)' without making an
+// ObjectMethod. Returns the index of the property name or -1.
+//
+// NOTE: Left alone when the callee has a jump in it, as in '(a ou o.f)',
+//       because the jump lands after the 'OpCode_Object_Get_Property'.
+//
+static int parser_take_back_property_get(Parser* parser, OperandStart left_start) {
+    Bytecode* bytecode = parser_get_current_bytecode(parser);
+    int get_offset = parser->function->property_get_offset_last;
+    if (get_offset == -1 || get_offset != bytecode->instructions.count - 2) return -1;
+    if (bytecode->instructions.items[get_offset] != OpCode_Object_Get_Property) return -1;
+
+    for (int offset = left_start.instruction_offset; offset < get_offset; offset += Bytecode_get_instruction_size(bytecode, offset)) {
+        OpCode opcode = Bytecode_get_jump_short_form(bytecode->instructions.items[offset]);
+        if (opcode == OpCode_Jump || opcode == OpCode_Jump_If_False || opcode == OpCode_Jump_If_True)
+            return -1;
+    }
+
+    int property_name_index = bytecode->instructions.items[get_offset + 1];
+    Bytecode_truncate(bytecode, get_offset, bytecode->values.count);
+    parser->function->property_get_offset_last = -1;
+
+    return property_name_index;
+}
+
+static Expression* parser_parse_operator_function_call(Parser* parser, Expression* left_operand, OperandStart left_start) {
     Token token_call = parser->token_previous;
+    int property_name_index = -1;
+    if (token_call.kind == Token_Left_Parenthesis)
+        property_name_index = parser_take_back_property_get(parser, left_start);
+
     uint8_t argument_count = parser_parse_arguments(parser, parser->token_previous.kind);
+    if (property_name_index != -1) {
+        int operand_index = Compiler_CompileInstruction_3Bytes(
+            parser_get_current_bytecode(parser),
+            OpCode_Call_Method,  // OpCode
+            property_name_index, // Operand 1
+            argument_count,      // Operand 2
+            parser->token_previous.line_number
+        );
+        parser->function->call_offset_last = operand_index - 2;
+        return NULL;
+    }
+
     OpCode opcode = 0;
     if (token_call.kind == Token_Left_Brace) {
         opcode = OpCode_Call_Class;
@@ -2509,12 +2844,14 @@ static Expression* parser_parse_operator_function_call(Parser* parser, Expressio
     else {
         opcode = OpCode_Call_Function;
     }
-    Compiler_CompileInstruction_2Bytes(
+    int operand_index = Compiler_CompileInstruction_2Bytes(
         parser_get_current_bytecode(parser),
         opcode,         // OpCode
         argument_count, // Operand
         parser->token_previous.line_number
     );
+    if (opcode == OpCode_Call_Function) parser->function->call_offset_last = operand_index - 1;
+
     return NULL;
 }
 
@@ -2540,14 +2877,10 @@ static Expression* parser_parse_operator_object_getter_and_setter(Parser* parser
 
     Value value_string = value_make_object_string(identifier_string);
     int property_name_index = -1;
-    Memory_transaction_push(value_string);
-    {
-        property_name_index = Compiler_CompileValue(
-            parser_get_current_bytecode(parser), 
-            value_string
-        );
-    }
-    Memory_transaction_pop();
+    property_name_index = Compiler_CompileValue(
+        parser_get_current_bytecode(parser), 
+        value_string
+    );
 
     if (can_assign && parser_match_then_advance(parser, Token_Equal)) {
         parser_parse_expression(parser, OperatorPrecedence_Assignment);
@@ -2560,21 +2893,23 @@ static Expression* parser_parse_operator_object_getter_and_setter(Parser* parser
     }
     else if (parser_match_then_advance(parser, Token_Left_Parenthesis)) {
         uint8_t argument_count = parser_parse_arguments(parser, Token_Left_Parenthesis);
-        Compiler_CompileInstruction_3Bytes(
+        int operand_index = Compiler_CompileInstruction_3Bytes(
             parser_get_current_bytecode(parser),
             OpCode_Call_Method,  // OpCode
             property_name_index, // Operand 1
             argument_count,      // Operand 2
             parser->token_previous.line_number
         );
+        parser->function->call_offset_last = operand_index - 2;
     } 
     else {
-        Compiler_CompileInstruction_2Bytes(
+        int operand_index = Compiler_CompileInstruction_2Bytes(
             parser_get_current_bytecode(parser),
             OpCode_Object_Get_Property,             // OpCode
             property_name_index,                    // Operand
             parser->token_previous.line_number
         );
+        parser->function->property_get_offset_last = operand_index - 1;
     }
 
     return NULL;
@@ -2630,6 +2965,21 @@ static void parser_end_scope(Parser* parser) {
     }
 }
 
+// NOTE: The ended Functions are kept in 'parser->functions_free' and reused,
+//       along with the room their locals and outsiders grew in the arena.
+//
+static Function* parser_allocate_function(Parser* parser) {
+    Function* function = parser->functions_free;
+    if (function == NULL) return Arena_Allocate(&parser->arena, Function);
+
+    parser->functions_free = function->next;
+    return function;
+}
+
+static void parser_release_function(Parser* parser, Function* function) {
+    LinkedList_push(parser->functions_free, function);
+}
+
 static void parser_init_function(Parser* parser, Function* function, FunctionKind function_kind, Token class_name) {
     ObjectFunction* object_fn = ObjectFunction_allocate(parser->object_head);
     if (function_kind != FunctionKind_Script) 
@@ -2650,13 +3000,15 @@ static void parser_init_function(Parser* parser, Function* function, FunctionKin
     function->object        = NULL;
     function->object        = object_fn;
     function->depth         = 0;
+    function->call_offset_last = -1;
+    function->property_get_offset_last = -1;
     function->class_name    = (Token) {0};
     if (class_name.kind != Token_Nil) 
         function->class_name = class_name;
 
-    StackLocal_init(&function->locals);
+    StackLocal_init(&function->locals, &parser->arena);
     StackLocal_push(&function->locals, local);
-    ArrayOutsider_init(&function->outsiders, 0);
+    ArrayOutsider_init(&function->outsiders, 0, &parser->arena);
     LinkedList_push(parser->function, function);
     DynamicArray_push(&parser->debugger_functions, function);
 }
@@ -2665,6 +3017,11 @@ static ObjectFunction* parser_end_function(Parser* parser, Function* function) {
     ObjectFunction* object_fn = parser->function->object;
 
     parser_compile_return(parser);
+    Bytecode_free_constants(&object_fn->bytecode);
+    if (parser->is_optimizing && !parser->had_error)
+        Bytecode_optimize(&object_fn->bytecode);
+    if (!parser->had_error)
+        object_fn->max_stack_depth = Bytecode_get_max_stack_depth(&object_fn->bytecode, object_fn->arity + 1);
 
     ///NOTE: I dont need to free(popped_function), because its a 
     //       stack value and it will be discaded by the caller function when returned.
@@ -2706,6 +3063,7 @@ int parser_resolve_variable_dependencies(Function* function, Token* name, Local*
         local_found_idx = StackLocal_get_local_index_by_token(&current_function->locals, name, NULL);
         if (local_found_idx != -1) {
             current_function->locals.items[local_found_idx].action = LocalAction_Move_Heap;
+            current_function->object->has_captured_locals = true;
             *ret_local = &current_function->locals.items[local_found_idx];
             break;
         }
@@ -2733,7 +3091,7 @@ int parser_resolve_variable_dependencies(Function* function, Token* name, Local*
         current_function = StackFunction_peek(&stack_function, 0);
         parent_local_idx = ArrayOutsider_add(
             &current_function->outsiders,
-            (uint8_t)parent_local_idx,
+            parent_local_idx,
             (is_top_item 
                 ? LocalLocation_In_Parent_Stack 
                 : LocalLocation_In_Parent_Heap_Values
@@ -2748,9 +3106,16 @@ int parser_resolve_variable_dependencies(Function* function, Token* name, Local*
     return parent_local_idx;
 }
 
+// NOTE: Releases everything the compiler allocated, including the statements
+//       returned by 'parser_parse'.
+//
 void Parser_free(Parser* parser) {
 // NOTE: Do not free parseer->objects, because Virtual Machine will need it
 //
-// TODO: Missing Implementation
-//
+    Arena_free(&parser->arena);
+    parser->functions_free = NULL;
+    parser->first_class_declaration = NULL;
+
+    DynamicArray_free(&parser->debugger_functions);
+    parser->debugger_functions = (DArrayFunction) {0};
 }
\ No newline at end of file
@@ -1,12 +1,35 @@
 #include "kriolu.h"
 
+void StackFunctionCall_init(StackFunctionCall* function_calls, int capacity, int capacity_max) {
+    if (capacity > capacity_max) capacity = capacity_max;
+
+    function_calls->items = (FunctionCall*)malloc(sizeof(FunctionCall) * capacity);
+    assert(function_calls->items && "Error: FunctionCall Stack out of memory.");
+
+    function_calls->top          = 0;
+    function_calls->capacity     = capacity;
+    function_calls->capacity_max = capacity_max;
+}
+
 void StackFunctionCall_reset(StackFunctionCall* function_calls) {
     function_calls->top = 0;
 }
 
+// NOTE: Growing moves the FunctionCalls, a pointer returned by 'push' or
+//       'peek' is only good until the next 'push'.
+//
 FunctionCall* StackFunctionCall_push(StackFunctionCall* function_calls, ObjectClosure* closure, Value* stack_value_top, int argument_count) {
-    assert(function_calls->top < FRAME_STACK_MAX);
-    if (function_calls->top == FRAME_STACK_MAX) return NULL;
+    if (function_calls->top == function_calls->capacity_max) return NULL;
+    if (function_calls->top == function_calls->capacity) {
+        int capacity = function_calls->capacity * 2;
+        if (capacity > function_calls->capacity_max) capacity = function_calls->capacity_max;
+
+        FunctionCall* items = (FunctionCall*)realloc(function_calls->items, sizeof(FunctionCall) * capacity);
+        if (items == NULL) return NULL;
+
+        function_calls->items    = items;
+        function_calls->capacity = capacity;
+    }
 
     FunctionCall* new_function_call = &function_calls->items[function_calls->top];
 
@@ -38,5 +61,14 @@ bool StackFunctionCall_is_empty(StackFunctionCall* function_calls) {
 }
 
 bool StackFunctionCall_is_full(StackFunctionCall* function_calls) {
-    return (function_calls->top == FRAME_STACK_MAX);
+    return (function_calls->top == function_calls->capacity_max);
+}
+
+void StackFunctionCall_free(StackFunctionCall* function_calls) {
+    free(function_calls->items);
+
+    function_calls->items        = NULL;
+    function_calls->top          = 0;
+    function_calls->capacity     = 0;
+    function_calls->capacity_max = 0;
 }
\ No newline at end of file
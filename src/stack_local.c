@@ -1,14 +1,26 @@
 #include "kriolu.h"
 
-void StackLocal_init(StackLocal* locals) {
-    // locals->items = malloc(capacity * sizeof(Local));
-    assert(locals->items);
+// NOTE: 'items' is left as is, a reused Function keeps the room its locals
+//       had the last time.
+//
+void StackLocal_init(StackLocal* locals, Arena* arena) {
     locals->top = 0;
-    locals->capacity = UINT8_COUNT;
+    locals->arena = arena;
 }
 
 Local StackLocal_push(StackLocal* locals, Local new_local) {
-    assert(locals->top < locals->capacity && "Error: StackLocal Overflow.");
+    assert(locals->top < LOCALS_MAX && "Error: StackLocal Overflow.");
+
+    if (locals->top == locals->capacity) {
+        int capacity = locals->capacity < 8 ? 8 : locals->capacity * 2;
+        locals->items = (Local*)Arena_reallocate(
+            locals->arena,
+            locals->items,
+            sizeof(Local) * locals->capacity,
+            sizeof(Local) * capacity
+        );
+        locals->capacity = capacity;
+    }
 
     // locals->items[locals->top] = (Local){ 
     //     .token       = token, 
@@ -55,7 +67,7 @@ int StackLocal_get_local_index_by_token(StackLocal* locals, Token* token, Local*
 }
 
 bool StackLocal_is_full(StackLocal* locals) {
-    return (locals->top == locals->capacity);
+    return (locals->top == LOCALS_MAX);
 }
 
 bool StackLocal_is_empty(StackLocal* locals) {
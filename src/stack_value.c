@@ -9,6 +9,17 @@
 //     return stack;
 // }
 
+void stack_value_init(StackValue* stack, int capacity, int capacity_max) {
+    if (capacity > capacity_max) capacity = capacity_max;
+
+    stack->items = (Value*)malloc(sizeof(Value) * capacity);
+    assert(stack->items && "Error: Stack out of memory.");
+
+    stack->top          = stack->items;
+    stack->capacity     = capacity;
+    stack->capacity_max = capacity_max;
+}
+
 void stack_value_reset(StackValue* stack) {
     stack->top = stack->items;
 }
@@ -19,7 +30,7 @@ static int stack_value_count(StackValue* stack) {
 }
 
 bool stack_value_is_full(StackValue* stack) {
-    return (stack_value_count(stack) == STACK_MAX);
+    return (stack_value_count(stack) == stack->capacity);
 }
 
 bool stack_value_is_empty(StackValue* stack) {
@@ -27,7 +38,7 @@ bool stack_value_is_empty(StackValue* stack) {
 }
 
 Value stack_value_push(StackValue* stack, Value value) {
-    assert(stack_value_count(stack) < STACK_MAX && "Error: Stack Overflow");
+    assert(stack_value_count(stack) < stack->capacity && "Error: Stack Overflow");
 
     *stack->top = value;
     stack->top += 1;
@@ -59,6 +70,11 @@ void stack_value_trace(StackValue* stack) {
     printf("\n");
 }
 
-void stack_free(StackValue* stack) {
-    free(stack);
+void stack_value_free(StackValue* stack) {
+    free(stack->items);
+
+    stack->items        = NULL;
+    stack->top          = NULL;
+    stack->capacity     = 0;
+    stack->capacity_max = 0;
 }
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "kriolu.h"
+
+// String Kernels
+//
+// Byte-level primitives behind the string natives (find, count, split and
+// compare). Each primitive has a scalar version and, on x86/x64, an SSE2 and
+// an AVX2 version. 'string_kernel_init' checks the CPU once and picks the
+// widest one available; until then the scalar kernels are used.
+//
+// The substring search compares the first and the last byte of the needle
+// against a whole block of the haystack at once, and only calls 'memcmp' for
+// the positions where both match.
+//
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define STRING_KERNEL_SSE2
+#       if defined(__x86_64__) || defined(_M_X64)
+#           define STRING_KERNEL_AVX2
+#       endif
+#       include <emmintrin.h>
+#       include <immintrin.h>
+#       if defined(_MSC_VER)
+#           include <intrin.h>
+#       endif
+#   endif
+#endif
+
+// NOTE: MSVC lets any function use AVX2 intrinsics, GCC and Clang need the
+//       function to be tagged with the target instead of building the whole
+//       file with '-mavx2' (that would let the compiler emit AVX2 in the
+//       scalar path too).
+//
+#if defined(__GNUC__) || defined(__clang__)
+#define STRING_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define STRING_KERNEL_TARGET_AVX2
+#endif
+
+static inline int string_kernel_count_trailing_zeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+//
+// Scalar
+//
+
+static int string_find_scalar_from(const char* haystack, int haystack_length, const char* needle, int needle_length, int start) {
+    char first = needle[0];
+    char last  = needle[needle_length - 1];
+
+    for (int i = start; i + needle_length <= haystack_length; i++) {
+        if (haystack[i] != first)                     continue;
+        if (haystack[i + needle_length - 1] != last)  continue;
+        if (needle_length <= 2 || memcmp(haystack + i + 1, needle + 1, needle_length - 2) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+static int string_find_scalar(const char* haystack, int haystack_length, const char* needle, int needle_length) {
+    return string_find_scalar_from(haystack, haystack_length, needle, needle_length, 0);
+}
+
+static int string_count_byte_scalar_from(const char* haystack, int length, char byte, int start) {
+    int count = 0;
+    for (int i = start; i < length; i++) {
+        if (haystack[i] == byte) count += 1;
+    }
+
+    return count;
+}
+
+static int string_count_byte_scalar(const char* haystack, int length, char byte) {
+    return string_count_byte_scalar_from(haystack, length, byte, 0);
+}
+
+static int string_mismatch_scalar_from(const char* a, const char* b, int length, int start) {
+    for (int i = start; i < length; i++) {
+        if (a[i] != b[i]) return i;
+    }
+
+    return length;
+}
+
+static int string_mismatch_scalar(const char* a, const char* b, int length) {
+    return string_mismatch_scalar_from(a, b, length, 0);
+}
+
+//
+// SSE2: 16 bytes per step
+//
+
+#ifdef STRING_KERNEL_SSE2
+
+static int string_find_sse2(const char* haystack, int haystack_length, const char* needle, int needle_length) {
+    int last_offset = needle_length - 1;
+    __m128i first   = _mm_set1_epi8(needle[0]);
+    __m128i last    = _mm_set1_epi8(needle[last_offset]);
+
+    int i = 0;
+    for (; i + last_offset + 16 <= haystack_length; i += 16) {
+        __m128i block_first = _mm_loadu_si128((const __m128i*)(haystack + i));
+        __m128i block_last  = _mm_loadu_si128((const __m128i*)(haystack + i + last_offset));
+        __m128i matches     = _mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first),
+            _mm_cmpeq_epi8(block_last, last)
+        );
+
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(matches);
+        while (mask != 0) {
+            int position = i + string_kernel_count_trailing_zeros(mask);
+            if (needle_length <= 2 || memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0)
+                return position;
+
+            mask &= mask - 1;
+        }
+    }
+
+    return string_find_scalar_from(haystack, haystack_length, needle, needle_length, i);
+}
+
+static int string_count_byte_sse2(const char* haystack, int length, char byte) {
+    __m128i target = _mm_set1_epi8(byte);
+    __m128i zero   = _mm_setzero_si128();
+    int count = 0;
+
+    int i = 0;
+    while (i + 16 <= length) {
+        // NOTE: every match subtracts -1 (0xFF) from its byte lane, so a lane
+        //       overflows after 255 blocks. The lanes are added up with
+        //       '_mm_sad_epu8' before that happens.
+        //
+        __m128i accumulator = zero;
+        for (int blocks = 0; blocks < 255 && i + 16 <= length; blocks++, i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(haystack + i));
+            accumulator   = _mm_sub_epi8(accumulator, _mm_cmpeq_epi8(block, target));
+        }
+
+        __m128i sums = _mm_sad_epu8(accumulator, zero);
+        count += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+
+    return count + string_count_byte_scalar_from(haystack, length, byte, i);
+}
+
+static int string_mismatch_sse2(const char* a, const char* b, int length) {
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i block_a = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i block_b = _mm_loadu_si128((const __m128i*)(b + i));
+
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block_a, block_b));
+        if (mask != 0xFFFF)
+            return i + string_kernel_count_trailing_zeros(~mask & 0xFFFF);
+    }
+
+    return string_mismatch_scalar_from(a, b, length, i);
+}
+
+#endif // STRING_KERNEL_SSE2
+
+//
+// AVX2: 32 bytes per step
+//
+
+#ifdef STRING_KERNEL_AVX2
+
+STRING_KERNEL_TARGET_AVX2
+static int string_find_avx2(const char* haystack, int haystack_length, const char* needle, int needle_length) {
+    int last_offset = needle_length - 1;
+    __m256i first   = _mm256_set1_epi8(needle[0]);
+    __m256i last    = _mm256_set1_epi8(needle[last_offset]);
+
+    int i = 0;
+    for (; i + last_offset + 32 <= haystack_length; i += 32) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i*)(haystack + i));
+        __m256i block_last  = _mm256_loadu_si256((const __m256i*)(haystack + i + last_offset));
+        __m256i matches     = _mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first),
+            _mm256_cmpeq_epi8(block_last, last)
+        );
+
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(matches);
+        while (mask != 0) {
+            int position = i + string_kernel_count_trailing_zeros(mask);
+            if (needle_length <= 2 || memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0)
+                return position;
+
+            mask &= mask - 1;
+        }
+    }
+
+    return string_find_scalar_from(haystack, haystack_length, needle, needle_length, i);
+}
+
+STRING_KERNEL_TARGET_AVX2
+static int string_count_byte_avx2(const char* haystack, int length, char byte) {
+    __m256i target = _mm256_set1_epi8(byte);
+    __m256i zero   = _mm256_setzero_si256();
+    int count = 0;
+
+    int i = 0;
+    while (i + 32 <= length) {
+        __m256i accumulator = zero;
+        for (int blocks = 0; blocks < 255 && i + 32 <= length; blocks++, i += 32) {
+            __m256i block = _mm256_loadu_si256((const __m256i*)(haystack + i));
+            accumulator   = _mm256_sub_epi8(accumulator, _mm256_cmpeq_epi8(block, target));
+        }
+
+        __m256i sums = _mm256_sad_epu8(accumulator, zero);
+        count += (int)(
+            _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+            _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3)
+        );
+    }
+
+    return count + string_count_byte_scalar_from(haystack, length, byte, i);
+}
+
+STRING_KERNEL_TARGET_AVX2
+static int string_mismatch_avx2(const char* a, const char* b, int length) {
+    int i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i block_a = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i block_b = _mm256_loadu_si256((const __m256i*)(b + i));
+
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_a, block_b));
+        if (mask != 0xFFFFFFFF)
+            return i + string_kernel_count_trailing_zeros(~mask);
+    }
+
+    return string_mismatch_scalar_from(a, b, length, i);
+}
+
+static bool string_kernel_cpu_supports_avx2(void) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // The OS must save the YMM registers on context switch (OSXSAVE + XCR0).
+    __cpuid(info, 1);
+    bool has_osxsave = (info[2] & (1 << 27)) != 0;
+    bool has_avx     = (info[2] & (1 << 28)) != 0;
+    if (!has_osxsave || !has_avx)        return false;
+    if ((_xgetbv(0) & 0x6) != 0x6)       return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+#endif // STRING_KERNEL_AVX2
+
+//
+// Dispatch
+//
+
+static StringKernel g_string_kernel_scalar = {
+    .name     = "scalar",
+    .find     = string_find_scalar,
+    .count    = string_count_byte_scalar,
+    .mismatch = string_mismatch_scalar,
+};
+
+#ifdef STRING_KERNEL_SSE2
+static StringKernel g_string_kernel_sse2 = {
+    .name     = "sse2",
+    .find     = string_find_sse2,
+    .count    = string_count_byte_sse2,
+    .mismatch = string_mismatch_sse2,
+};
+#endif // STRING_KERNEL_SSE2
+
+#ifdef STRING_KERNEL_AVX2
+static StringKernel g_string_kernel_avx2 = {
+    .name     = "avx2",
+    .find     = string_find_avx2,
+    .count    = string_count_byte_avx2,
+    .mismatch = string_mismatch_avx2,
+};
+#endif // STRING_KERNEL_AVX2
+
+static StringKernel* g_string_kernel = &g_string_kernel_scalar;
+
+void string_kernel_init(void) {
+    g_string_kernel = &g_string_kernel_scalar;
+
+#ifdef STRING_KERNEL_SSE2
+    g_string_kernel = &g_string_kernel_sse2;
+#endif // STRING_KERNEL_SSE2
+
+#ifdef STRING_KERNEL_AVX2
+    if (string_kernel_cpu_supports_avx2())
+        g_string_kernel = &g_string_kernel_avx2;
+#endif // STRING_KERNEL_AVX2
+}
+
+StringKernel* string_kernel_get(void) {
+    return g_string_kernel;
+}
+
+// Returns the index of the first occurrence of 'needle' in 'haystack', or -1.
+// An empty needle is found at index 0.
+//
+int string_find(String haystack, String needle) {
+    if (needle.length == 0)               return 0;
+    if (needle.length > haystack.length)  return -1;
+
+    return g_string_kernel->find(haystack.characters, haystack.length, needle.characters, needle.length);
+}
+
+// Counts non-overlapping occurrences of 'needle' in 'haystack'.
+//
+int string_count(String haystack, String needle) {
+    if (needle.length == 0)               return 0;
+    if (needle.length > haystack.length)  return 0;
+    if (needle.length == 1)
+        return g_string_kernel->count(haystack.characters, haystack.length, needle.characters[0]);
+
+    int count = 0;
+    int start = 0;
+    while (start + needle.length <= haystack.length) {
+        int index = g_string_kernel->find(
+            haystack.characters + start,
+            haystack.length - start,
+            needle.characters,
+            needle.length
+        );
+        if (index < 0) break;
+
+        count += 1;
+        start += index + needle.length;
+    }
+
+    return count;
+}
+
+// Byte-wise comparison (like 'strcmp', but '\0' is just another byte).
+// Returns a negative number, 0 or a positive number.
+//
+int string_compare(String a, String b) {
+    int length   = a.length < b.length ? a.length : b.length;
+    int mismatch = g_string_kernel->mismatch(a.characters, b.characters, length);
+
+    if (mismatch < length)
+        return (int)(uint8_t)a.characters[mismatch] - (int)(uint8_t)b.characters[mismatch];
+
+    return a.length - b.length;
+}
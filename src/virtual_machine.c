@@ -11,13 +11,21 @@
 
 void VirtualMachine_runtime_error(VirtualMachine* vm, const char* format, ...);
 static void VirtualMachine_define_function_native(VirtualMachine* vm, const char* function_name, FunctionNative* function, int arity);
+static bool VirtualMachine_reserve_stack_value(VirtualMachine* vm, int count);
 static bool VirtualMachine_call_closure(VirtualMachine* vm, ObjectClosure* closure, int argument_count);
+static bool VirtualMachine_tail_call_closure(VirtualMachine* vm, ObjectClosure* closure, int argument_count);
 static bool VirtualMachine_call_value(VirtualMachine* vm, Value function, int argument_count);
-static bool VirtualMachine_call_method(VirtualMachine* vm, ObjectString* name, int argument_count);
-static bool VirtualMachine_call_from_class(VirtualMachine* vm, ObjectClass* klass, ObjectString* method_name, int argument_count);
+static bool VirtualMachine_call_method(VirtualMachine* vm, ObjectString* name, int argument_count, bool is_tail);
+static bool VirtualMachine_call_from_class(VirtualMachine* vm, ObjectClass* klass, ObjectString* method_name, int argument_count, bool is_tail);
 static ObjectValue* VirtualMachine_create_heap_value(VirtualMachine* vm, Value* value_address);
+static ObjectClosure* VirtualMachine_make_closure(VirtualMachine* vm, ObjectFunction* function);
+static void VirtualMachine_bind_method(VirtualMachine* vm, ObjectString* method_name, ObjectClosure* method);
 static void VirtualMachine_move_value_from_stack_to_heap(VirtualMachine* vm, Value* value_address);
 static Value FunctionNative_clock(VirtualMachine* vm, int argument_count, Value* arguments);
+static Value FunctionNative_string_find(VirtualMachine* vm, int argument_count, Value* arguments);
+static Value FunctionNative_string_count(VirtualMachine* vm, int argument_count, Value* arguments);
+static Value FunctionNative_string_split(VirtualMachine* vm, int argument_count, Value* arguments);
+static Value FunctionNative_string_compare(VirtualMachine* vm, int argument_count, Value* arguments);
 
 static bool Debugger_read_commands(VirtualMachine* vm, bool* d_execution_pause, bool* d_execution_resume,char** out_error_msg);
 
@@ -42,21 +50,31 @@ static ObjectString* VirtualMachine_intern_string(VirtualMachine* vm, String str
     return result;
 }
 
-void VirtualMachine_init(VirtualMachine* vm) {
+void VirtualMachine_init(VirtualMachine* vm, VirtualMachineInitParams params) {
     String konstrutor      = string_make("konstrutor", 10);
+    int stack_value_max    = params.stack_value_max > 0 ? params.stack_value_max : STACK_VALUE_CAPACITY_MAX;
+    int function_calls_max = params.function_calls_max > 0 ? params.function_calls_max : FRAME_STACK_MAX;
 
     vm->objects            = NULL;
-    vm->heap_values        = NULL;
+    vm->objects_permanent  = NULL;
     vm->object_init_text   = "konstrutor";
-    stack_value_reset(&vm->stack_value);
-    StackFunctionCall_reset(&vm->function_calls);
+    stack_value_init(&vm->stack_value, STACK_VALUE_CAPACITY, stack_value_max);
+    StackFunctionCall_init(&vm->function_calls, FRAME_MAX, function_calls_max);
+    vm->heap_values        = (ObjectValue**)calloc(vm->stack_value.capacity, sizeof(ObjectValue*));
+    assert(vm->heap_values);
     hash_table_init(&vm->global_database);
     hash_table_init(&vm->string_database);
 
-    Memory_register(NULL, vm, NULL);
+    Memory_register(NULL, vm);
+
+    string_kernel_init();
 
     vm->object_init_string = VirtualMachine_intern_string(vm, konstrutor);
     VirtualMachine_define_function_native(vm, "rilogio", &FunctionNative_clock, 0);
+    VirtualMachine_define_function_native(vm, "buska", &FunctionNative_string_find, 2);
+    VirtualMachine_define_function_native(vm, "konta", &FunctionNative_string_count, 2);
+    VirtualMachine_define_function_native(vm, "parti", &FunctionNative_string_split, 3);
+    VirtualMachine_define_function_native(vm, "kompara", &FunctionNative_string_compare, 2);
 }
 
 
@@ -66,9 +84,14 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
     bool debugger_execution_pause  = false;
     bool debugger_execution_resume = false;
 
+    if (!VirtualMachine_reserve_stack_value(vm, script->max_stack_depth + STACK_VALUE_HEADROOM)) {
+        VirtualMachine_runtime_error(vm, "Stack Overflow.");
+        return Interpreter_Runtime_Error;
+    }
+
     Value value = value_make_object(script);
     stack_value_push(&vm->stack_value, value);
-    ObjectClosure* closure = ObjectClosure_allocate(script, &vm->objects);
+    ObjectClosure* closure = VirtualMachine_make_closure(vm, script);
     stack_value_pop(&vm->stack_value);
     Value v_closure = value_make_object(closure);
     stack_value_push(&vm->stack_value, v_closure);
@@ -86,6 +109,15 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
 #define READ_CONSTANT() (current_function_call->closure->function->bytecode.values.items[READ_BYTE_THEN_INCREMENT()])
 #define READ_CONSTANT_3BYTE() (current_function_call->closure->function->bytecode.values.items[READ_3BYTE_THEN_INCREMENT()])
 #define READ_STRING() value_as_string(READ_CONSTANT())
+#define READ_JUMP_DISTANCE_LONG() ((int)value_as_number(current_function_call->closure->function->bytecode.values.items[READ_2BYTE()]))
+
+    // NOTE: Unchecked, the room for the whole frame is reserved when the
+    //       function is called (see 'VirtualMachine_call_closure').
+    //
+#define STACK_PUSH(value) (*vm->stack_value.top++ = (value))
+#define STACK_POP() (*--vm->stack_value.top)
+#define STACK_DROP() ((void)--vm->stack_value.top)
+#define STACK_PEEK(offset) (vm->stack_value.top[-1 - (offset)])
     // TODO: #define READ_STRING_3BYTE() (...)
 
 #ifdef DEBUG_TRACE_EXECUTION
@@ -115,31 +147,35 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         case OpCode_Stack_Push_Literal:
         {
             Value constant = READ_CONSTANT();
-            stack_value_push(&vm->stack_value, constant);
+            STACK_PUSH(constant);
             break;
         }
         case OpCode_Stack_Push_Literal_Long:
         {
             Value constant = READ_CONSTANT_3BYTE();
-            stack_value_push(&vm->stack_value, constant);
+            STACK_PUSH(constant);
             break;
         }
         case OpCode_Stack_Push_Closure:
         {
             ObjectFunction* function = value_as_function_object(READ_CONSTANT());
-            ObjectClosure* closure = ObjectClosure_allocate(function, &vm->objects);
-            stack_value_push(&vm->stack_value, value_make_object(closure));
+            ObjectClosure* closure = VirtualMachine_make_closure(vm, function);
+            STACK_PUSH(value_make_object(closure));
             for (int i = 0; i < closure->function->outsiders_count; i++) {
-                uint8_t local_location       = READ_BYTE_THEN_INCREMENT();
-                uint8_t local_location_index = READ_BYTE_THEN_INCREMENT();
+                uint8_t local_location   = READ_BYTE_THEN_INCREMENT();
+                int local_location_index = READ_BYTE_THEN_INCREMENT();
+                if (local_location & LOCAL_LOCATION_INDEX_LONG) {
+                    local_location &= ~LOCAL_LOCATION_INDEX_LONG;
+                    local_location_index = (local_location_index << 8) | READ_BYTE_THEN_INCREMENT();
+                }
                 if (local_location == LocalLocation_In_Parent_Stack) {
-                    closure->heap_values.items[i] = VirtualMachine_create_heap_value(
+                    closure->heap_values[i] = VirtualMachine_create_heap_value(
                         vm,
                         current_function_call->frame_start + local_location_index
                     );
                 } 
                 else if (local_location == LocalLocation_In_Parent_Heap_Values) { 
-                    closure->heap_values.items[i] = current_function_call->closure->heap_values.items[local_location_index];
+                    closure->heap_values[i] = current_function_call->closure->heap_values[local_location_index];
                 }
                 else {
 //                  TODO: review error message
@@ -151,16 +187,20 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         case OpCode_Stack_Push_Closure_Long:
         {
             ObjectFunction* function = value_as_function_object(READ_CONSTANT_3BYTE());
-            ObjectClosure* closure = ObjectClosure_allocate(function, &vm->objects);
-            stack_value_push(&vm->stack_value, value_make_object(closure));
+            ObjectClosure* closure = VirtualMachine_make_closure(vm, function);
+            STACK_PUSH(value_make_object(closure));
             for (int i = 0; i < closure->function->outsiders_count; i++) {
                 uint8_t local_location = READ_BYTE_THEN_INCREMENT(); // TODO: rename to 'local_location'
-                uint8_t local_location_index = READ_BYTE_THEN_INCREMENT();
+                int local_location_index = READ_BYTE_THEN_INCREMENT();
+                if (local_location & LOCAL_LOCATION_INDEX_LONG) {
+                    local_location &= ~LOCAL_LOCATION_INDEX_LONG;
+                    local_location_index = (local_location_index << 8) | READ_BYTE_THEN_INCREMENT();
+                }
                 if (local_location == LocalLocation_In_Parent_Stack) { // TODO: change line to 'if(local_location == LocalLocation_In_Parent_Stack) {...}'
-                    closure->heap_values.items[i] = VirtualMachine_create_heap_value(vm, current_function_call->frame_start + local_location_index);
+                    closure->heap_values[i] = VirtualMachine_create_heap_value(vm, current_function_call->frame_start + local_location_index);
                 } 
                 else if (local_location == LocalLocation_In_Parent_Heap_Values) {
-                    closure->heap_values.items[i] = current_function_call->closure->heap_values.items[local_location_index];
+                    closure->heap_values[i] = current_function_call->closure->heap_values[local_location_index];
                 }
                 else {
                     VirtualMachine_runtime_error(vm, "Could not Close the variable: invalid location.");
@@ -170,17 +210,17 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         }
         case OpCode_Stack_Push_Literal_True:
         {
-            stack_value_push(&vm->stack_value, value_make_boolean(true));
+            STACK_PUSH(value_make_boolean(true));
             break;
         }
         case OpCode_Stack_Push_Literal_False:
         {
-            stack_value_push(&vm->stack_value, value_make_boolean(false));
+            STACK_PUSH(value_make_boolean(false));
             break;
         }
         case OpCode_Stack_Push_Literal_Nil:
         {
-            stack_value_push(&vm->stack_value, value_make_nil());
+            STACK_PUSH(value_make_nil());
             break;
         }
         case OpCode_Stack_Copy_From_idx_To_Top:
@@ -188,7 +228,16 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
             uint8_t local_slot_index = READ_BYTE_THEN_INCREMENT();
 
             Value local = current_function_call->frame_start[local_slot_index];
-            stack_value_push(&vm->stack_value, local);
+            STACK_PUSH(local);
+
+            break;
+        }
+        case OpCode_Stack_Copy_From_idx_To_Top_Long:
+        {
+            uint16_t local_slot_index = READ_2BYTE();
+
+            Value local = current_function_call->frame_start[local_slot_index];
+            STACK_PUSH(local);
 
             break;
         }
@@ -196,39 +245,53 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         {
             uint8_t local_slot_index = READ_BYTE_THEN_INCREMENT();
 
-            current_function_call->frame_start[local_slot_index] = stack_value_peek(&vm->stack_value, 0);
+            current_function_call->frame_start[local_slot_index] = STACK_PEEK(0);
+            break;
+        }
+        case OpCode_Stack_Copy_Top_To_Idx_Long:
+        {
+            uint16_t local_slot_index = READ_2BYTE();
+
+            current_function_call->frame_start[local_slot_index] = STACK_PEEK(0);
             break;
         }
         case OpCode_Stack_Move_Value_To_Heap: {
 //          Note: this instruction is emitted at the 'Parser_end_scope()'.
             VirtualMachine_move_value_from_stack_to_heap(vm, vm->stack_value.top - 1);
-            stack_value_pop(&vm->stack_value);
+            STACK_DROP();
             break;
         }
         case OpCode_Stack_Move_Top_To_Heap: {
             uint8_t index = READ_BYTE_THEN_INCREMENT();
-            *current_function_call->closure->heap_values.items[index]->value_address = stack_value_peek(&vm->stack_value, 0);
+            *current_function_call->closure->heap_values[index]->value_address = STACK_PEEK(0);
+            break;
+        }
+        case OpCode_Stack_Move_Top_To_Heap_Long: {
+            uint16_t index = READ_2BYTE();
+            *current_function_call->closure->heap_values[index]->value_address = STACK_PEEK(0);
             break;
         }
         case OpCode_Stack_Copy_From_Heap_To_Top: {
             uint8_t index = READ_BYTE_THEN_INCREMENT();
-            stack_value_push(
-                &vm->stack_value,
-                *current_function_call->closure->heap_values.items[index]->value_address
-            );
+            STACK_PUSH(*current_function_call->closure->heap_values[index]->value_address);
+            break;
+        }
+        case OpCode_Stack_Copy_From_Heap_To_Top_Long: {
+            uint16_t index = READ_2BYTE();
+            STACK_PUSH(*current_function_call->closure->heap_values[index]->value_address);
             break;
         }
         case OpCode_Stack_Pop:
         {
-            stack_value_pop(&vm->stack_value);
+            STACK_DROP();
             break;
         }
         case OpCode_Define_Global:
         {
             ObjectString* variable_name = READ_STRING();
-            Value value = stack_value_peek(&vm->stack_value, 0);
+            Value value = STACK_PEEK(0);
             hash_table_set_value(&vm->global_database, variable_name, value);
-            stack_value_pop(&vm->stack_value);
+            STACK_DROP();
             break;
         }
         case OpCode_Read_Global:
@@ -241,13 +304,13 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
                 return Interpreter_Runtime_Error;
             }
 //          TODO??: attach variable-name into value, if it's type is a instance
-            stack_value_push(&vm->stack_value, value);
+            STACK_PUSH(value);
             break;
         }
         case OpCode_Assign_Global:
         {
             ObjectString* variable_name = READ_STRING();
-            Value value = stack_value_peek(&vm->stack_value, 0);
+            Value value = STACK_PEEK(0);
             bool is_new = hash_table_set_value(&vm->global_database, variable_name, value);
             if (is_new) {
                 hash_table_delete(&vm->global_database, variable_name);
@@ -261,7 +324,7 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         case OpCode_Call_Function:
         {
             int argument_count = READ_BYTE_THEN_INCREMENT();
-            Value function = stack_value_peek(&vm->stack_value, argument_count);
+            Value function = STACK_PEEK(argument_count);
             if (value_as_object(function)->kind == ObjectKind_Class) {
                 VirtualMachine_runtime_error(vm, "Expect a 'Funson' to call.\n-- Did you meant '%s{}'", value_as_class(function)->name->characters);
                 return Interpreter_Runtime_Error;
@@ -274,9 +337,28 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
             current_function_call = StackFunctionCall_peek(&vm->function_calls, 0);
             break;
         }
+        case OpCode_Call_Function_Tail:
+        {
+            int argument_count = READ_BYTE_THEN_INCREMENT();
+            Value function = STACK_PEEK(argument_count);
+            if (value_as_object(function)->kind == ObjectKind_Class) {
+                VirtualMachine_runtime_error(vm, "Expect a 'Funson' to call.\n-- Did you meant '%s{}'", value_as_class(function)->name->characters);
+                return Interpreter_Runtime_Error;
+            }
+
+            bool is_called = value_is_closure(function)
+                ? VirtualMachine_tail_call_closure(vm, value_as_closure(function), argument_count)
+                : VirtualMachine_call_value(vm, function, argument_count);
+            if (!is_called) {
+                return Interpreter_Runtime_Error;
+            }
+
+            current_function_call = StackFunctionCall_peek(&vm->function_calls, 0);
+            break;
+        }
         case OpCode_Call_Class: {
             int argument_count = READ_BYTE_THEN_INCREMENT();
-            Value function = stack_value_peek(&vm->stack_value, argument_count);
+            Value function = STACK_PEEK(argument_count);
             if (value_as_object(function)->kind != ObjectKind_Class) {
                 VirtualMachine_runtime_error(vm, "Expect a Class to call the 'konstrutor'.");
                 return Interpreter_Runtime_Error;
@@ -291,10 +373,12 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
             break;
         }
         case OpCode_Call_Method: 
+        case OpCode_Call_Method_Tail:
         {
             ObjectString* method_name = READ_STRING();
             int argument_count = READ_BYTE_THEN_INCREMENT();
-            if (!VirtualMachine_call_method(vm, method_name, argument_count)) {
+            bool is_tail = (instruction == OpCode_Call_Method_Tail);
+            if (!VirtualMachine_call_method(vm, method_name, argument_count, is_tail)) {
                 return Interpreter_Runtime_Error;
             }
             
@@ -302,11 +386,13 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
             break;
         }
         case OpCode_Call_Super_Method:
+        case OpCode_Call_Super_Method_Tail:
         {
             ObjectString* method_name = READ_STRING();
             int argument_count = READ_BYTE_THEN_INCREMENT();
-            ObjectClass* superclass = value_as_class(stack_value_pop(&vm->stack_value));
-            if (!VirtualMachine_call_from_class(vm, superclass, method_name, argument_count)) {
+            bool is_tail = (instruction == OpCode_Call_Super_Method_Tail);
+            ObjectClass* superclass = value_as_class(STACK_POP());
+            if (!VirtualMachine_call_from_class(vm, superclass, method_name, argument_count, is_tail)) {
                 return Interpreter_Runtime_Error;
             }
 
@@ -318,45 +404,38 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         {
             ObjectClass* klass = ObjectClass_alocate(READ_STRING(), &vm->objects);
             Value klass_value = value_make_object(klass);
-            stack_value_push(&vm->stack_value, klass_value);
+            STACK_PUSH(klass_value);
             break;
         }
 //      TODO: rename to 'OpCode_Attach_Method_To_Class'
         case OpCode_Method: 
         {
             ObjectString* method_name = READ_STRING();
-            Value closure_method = stack_value_peek(&vm->stack_value, 0);
-            ObjectClass* klass = value_as_class(stack_value_peek(&vm->stack_value, 1));
+            Value closure_method = STACK_PEEK(0);
+            ObjectClass* klass = value_as_class(STACK_PEEK(1));
             hash_table_set_value(&klass->methods, method_name, closure_method);
-            stack_value_pop(&vm->stack_value);
+            STACK_DROP();
             break;
         }
         case OpCode_Inheritance:
         {
-            ObjectClass* subclass = value_as_class(stack_value_peek(&vm->stack_value, 0));
-            Value superclass = stack_value_peek(&vm->stack_value, 1);
+            ObjectClass* subclass = value_as_class(STACK_PEEK(0));
+            Value superclass = STACK_PEEK(1);
             if (!value_is_class(superclass)) 
                 VirtualMachine_runtime_error(vm, "Superclass must be a class.");
             
             hash_table_copy(&value_as_class(superclass)->methods, &subclass->methods);
-            stack_value_pop(&vm->stack_value);
+            STACK_DROP();
             break;
         }
         case OpCode_Get_Super: 
         {
             ObjectString* method_name = READ_STRING();
-            ObjectClass* superclass = value_as_class(stack_value_pop(&vm->stack_value));
+            ObjectClass* superclass = value_as_class(STACK_POP());
 
             Value closure_method;
             if (hash_table_get_value(&superclass->methods, method_name, &closure_method)) {
-                ObjectMethod* obj_method = ObjectMethod_allocate(
-                    stack_value_peek(&vm->stack_value, 0), 
-                    value_as_closure(closure_method),
-                    &vm->objects
-                );
-
-                stack_value_pop(&vm->stack_value); // NOTE: Pop the Instance
-                stack_value_push(&vm->stack_value, value_make_object_method(obj_method));
+                VirtualMachine_bind_method(vm, method_name, value_as_closure(closure_method));
                 break;
             }
 
@@ -365,33 +444,26 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         }
         case OpCode_Object_Get_Property:
         {
-            if (!value_is_instance(stack_value_peek(&vm->stack_value, 0))) {
+            if (!value_is_instance(STACK_PEEK(0))) {
                 VirtualMachine_runtime_error(vm, "Only instances have properties.");
                 return Interpreter_Runtime_Error;
             }
 
-            ObjectInstance* obj_instance = value_as_instance(stack_value_peek(&vm->stack_value, 0));
+            ObjectInstance* obj_instance = value_as_instance(STACK_PEEK(0));
             ObjectString* property_name  = READ_STRING();
 
 //          First, It looks for 'property-name' in the Instance's fields hash-table, and 
 //          if it didn't find any item, It searchs in the Class's methods hash-table.
             Value value;
             if (hash_table_get_value(&obj_instance->fields, property_name, &value)) {
-                stack_value_pop(&vm->stack_value); // NOTE: Pop the Instance
-                stack_value_push(&vm->stack_value, value);
+                STACK_DROP(); // NOTE: Pop the Instance
+                STACK_PUSH(value);
                 break;
             }
             
             Value closure_method;
             if (hash_table_get_value(&obj_instance->klass->methods, property_name, &closure_method)) {
-                ObjectMethod* obj_method = ObjectMethod_allocate(
-                    stack_value_peek(&vm->stack_value, 0), 
-                    value_as_closure(closure_method),
-                    &vm->objects
-                );
-
-                stack_value_pop(&vm->stack_value); // NOTE: Pop the Instance
-                stack_value_push(&vm->stack_value, value_make_object_method(obj_method));
+                VirtualMachine_bind_method(vm, property_name, value_as_closure(closure_method));
                 break;
             }
 
@@ -400,47 +472,47 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         }
         case OpCode_Object_Set_Property:
         {
-            if (!value_is_instance(stack_value_peek(&vm->stack_value, 1))) {
+            if (!value_is_instance(STACK_PEEK(1))) {
                 VirtualMachine_runtime_error(vm, "Only instances have properties.");
                 return Interpreter_Runtime_Error;
             }
 
-            ObjectInstance* instance      = value_as_instance(stack_value_peek(&vm->stack_value, 1));
+            ObjectInstance* instance      = value_as_instance(STACK_PEEK(1));
             ObjectString*   property_name = READ_STRING();
 
             hash_table_set_value(
                 &instance->fields, 
                 property_name, 
-                stack_value_peek(&vm->stack_value, 0)
+                STACK_PEEK(0)
             );
 
-            Value value = stack_value_pop(&vm->stack_value);
-            stack_value_pop(&vm->stack_value);  // NOTE: Pop the Instance
-            stack_value_push(&vm->stack_value, value);
+            Value value = STACK_POP();
+            STACK_DROP();  // NOTE: Pop the Instance
+            STACK_PUSH(value);
     
             break;
         }
         case OpCode_Negation:
         {
-            if (!value_is_number(stack_value_peek(&vm->stack_value, 0)))
+            if (!value_is_number(STACK_PEEK(0)))
             {
                 VirtualMachine_runtime_error(vm, "Operand must be a number.");
                 return Interpreter_Runtime_Error;
             }
 
-            Value value = stack_value_pop(&vm->stack_value);
+            Value value = STACK_POP();
             double number = value_as_number(value);
             Value value_negated = value_make_number(-(number));
 
-            stack_value_push(&vm->stack_value, value_negated);
+            STACK_PUSH(value_negated);
             break;
         }
         case OpCode_Not:
         {
-            bool result = value_negate_logically(stack_value_pop(&vm->stack_value));
+            bool result = value_negate_logically(STACK_POP());
             Value value = value_make_boolean(result);
 
-            stack_value_push(&vm->stack_value, value);
+            STACK_PUSH(value);
             break;
         }
         case OpCode_Interpolation:
@@ -463,22 +535,22 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         case OpCode_Add:
         {
             if (
-                value_is_number(stack_value_peek(&vm->stack_value, 0)) &&
-                value_is_number(stack_value_peek(&vm->stack_value, 1))
+                value_is_number(STACK_PEEK(0)) &&
+                value_is_number(STACK_PEEK(1))
             ) {
-                Value b = stack_value_pop(&vm->stack_value);
-                Value a = stack_value_pop(&vm->stack_value);
+                Value b = STACK_POP();
+                Value a = STACK_POP();
                 double sum = value_as_number(a) + value_as_number(b);
                 Value value_sum = value_make_number(sum);
 
-                stack_value_push(&vm->stack_value, value_sum);
+                STACK_PUSH(value_sum);
             } 
             else if (
-                value_is_string(stack_value_peek(&vm->stack_value, 0)) &&
-                value_is_string(stack_value_peek(&vm->stack_value, 1))
+                value_is_string(STACK_PEEK(0)) &&
+                value_is_string(STACK_PEEK(1))
             ) {
-                Value b             = stack_value_peek(&vm->stack_value, 0);
-                Value a             = stack_value_peek(&vm->stack_value, 1);
+                Value b             = STACK_PEEK(0);
+                Value a             = STACK_PEEK(1);
                 ObjectString* os_a  = value_as_string(a);
                 ObjectString* os_b  = value_as_string(b);
                 String s_a          = string_make(os_a->characters, os_a->length);
@@ -501,9 +573,9 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
                     string_free(&final);
                 }
 
-                stack_value_pop(&vm->stack_value);
-                stack_value_pop(&vm->stack_value);
-                stack_value_push(&vm->stack_value, value_make_object(object_st));
+                STACK_DROP();
+                STACK_DROP();
+                STACK_PUSH(value_make_object(object_st));
             } else {
                 VirtualMachine_runtime_error(vm, "Operands must be 2(two) numbers or 2(two) strings.");
                 return Interpreter_Runtime_Error;
@@ -513,115 +585,115 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         }
         case OpCode_Subtract:
         {
-            if (!value_is_number(stack_value_peek(&vm->stack_value, 0)) ||
-                !value_is_number(stack_value_peek(&vm->stack_value, 1)))
+            if (!value_is_number(STACK_PEEK(0)) ||
+                !value_is_number(STACK_PEEK(1)))
             {
                 VirtualMachine_runtime_error(vm, "Operands must be numbers.");
                 return Interpreter_Runtime_Error;
             }
 
-            Value b = stack_value_pop(&vm->stack_value);
-            Value a = stack_value_pop(&vm->stack_value);
+            Value b = STACK_POP();
+            Value a = STACK_POP();
             double difference = value_as_number(a) - value_as_number(b);
             Value value_difference = value_make_number(difference);
 
-            stack_value_push(&vm->stack_value, value_difference);
+            STACK_PUSH(value_difference);
             break;
         }
         case OpCode_Multiply:
         {
-            if (!value_is_number(stack_value_peek(&vm->stack_value, 0)) ||
-                !value_is_number(stack_value_peek(&vm->stack_value, 1)))
+            if (!value_is_number(STACK_PEEK(0)) ||
+                !value_is_number(STACK_PEEK(1)))
             {
                 VirtualMachine_runtime_error(vm, "Operands must be numbers.");
                 return Interpreter_Runtime_Error;
             }
 
-            Value b = stack_value_pop(&vm->stack_value);
-            Value a = stack_value_pop(&vm->stack_value);
+            Value b = STACK_POP();
+            Value a = STACK_POP();
             double product = value_as_number(a) * value_as_number(b);
             Value value_product = value_make_number(product);
 
-            stack_value_push(&vm->stack_value, value_product);
+            STACK_PUSH(value_product);
             break;
         }
         case OpCode_Divide:
         {
-            if (!value_is_number(stack_value_peek(&vm->stack_value, 0)) ||
-                !value_is_number(stack_value_peek(&vm->stack_value, 1)))
+            if (!value_is_number(STACK_PEEK(0)) ||
+                !value_is_number(STACK_PEEK(1)))
             {
                 VirtualMachine_runtime_error(vm, "Operands must be numbers.");
                 return Interpreter_Runtime_Error;
             }
 
-            Value b = stack_value_pop(&vm->stack_value);
-            Value a = stack_value_pop(&vm->stack_value);
+            Value b = STACK_POP();
+            Value a = STACK_POP();
             double quotient = value_as_number(a) / value_as_number(b);
             Value value_quotient = value_make_number(quotient);
 
-            stack_value_push(&vm->stack_value, value_quotient);
+            STACK_PUSH(value_quotient);
             break;
         }
         case OpCode_Exponentiation:
         {
-            if (!value_is_number(stack_value_peek(&vm->stack_value, 0)) ||
-                !value_is_number(stack_value_peek(&vm->stack_value, 1)))
+            if (!value_is_number(STACK_PEEK(0)) ||
+                !value_is_number(STACK_PEEK(1)))
             {
                 VirtualMachine_runtime_error(vm, "Operands must be numbers.");
                 return Interpreter_Runtime_Error;
             }
 
-            Value b = stack_value_pop(&vm->stack_value);
-            Value a = stack_value_pop(&vm->stack_value);
+            Value b = STACK_POP();
+            Value a = STACK_POP();
             double power = pow(value_as_number(a), value_as_number(b));
             Value value_power = value_make_number(power);
 
-            stack_value_push(&vm->stack_value, value_power);
+            STACK_PUSH(value_power);
             break;
         }
         case OpCode_Equal_To:
         {
-            Value b = stack_value_pop(&vm->stack_value);
-            Value a = stack_value_pop(&vm->stack_value);
+            Value b = STACK_POP();
+            Value a = STACK_POP();
             bool is_equal = value_is_equal(a, b);
-            stack_value_push(&vm->stack_value, value_make_boolean(is_equal));
+            STACK_PUSH(value_make_boolean(is_equal));
             break;
         }
         case OpCode_Greater_Than:
         {
-            if (!value_is_number(stack_value_peek(&vm->stack_value, 0)) ||
-                !value_is_number(stack_value_peek(&vm->stack_value, 1)))
+            if (!value_is_number(STACK_PEEK(0)) ||
+                !value_is_number(STACK_PEEK(1)))
             {
                 VirtualMachine_runtime_error(vm, "Operands must be numbers.");
                 return Interpreter_Runtime_Error;
             }
 
-            Value b = stack_value_pop(&vm->stack_value);
-            Value a = stack_value_pop(&vm->stack_value);
+            Value b = STACK_POP();
+            Value a = STACK_POP();
             bool result = (value_as_number(a) > value_as_number(b));
 
-            stack_value_push(&vm->stack_value, value_make_boolean(result));
+            STACK_PUSH(value_make_boolean(result));
             break;
         }
         case OpCode_Less_Than:
         {
-            if (!value_is_number(stack_value_peek(&vm->stack_value, 0)) ||
-                !value_is_number(stack_value_peek(&vm->stack_value, 1)))
+            if (!value_is_number(STACK_PEEK(0)) ||
+                !value_is_number(STACK_PEEK(1)))
             {
                 VirtualMachine_runtime_error(vm, "Operands must be numbers.");
                 return Interpreter_Runtime_Error;
             }
 
-            Value b = stack_value_pop(&vm->stack_value);
-            Value a = stack_value_pop(&vm->stack_value);
+            Value b = STACK_POP();
+            Value a = STACK_POP();
             bool result = (value_as_number(a) < value_as_number(b));
 
-            stack_value_push(&vm->stack_value, value_make_boolean(result));
+            STACK_PUSH(value_make_boolean(result));
             break;
         }
         case OpCode_Print:
         {
-            Value value = stack_value_pop(&vm->stack_value);
+            Value value = STACK_POP();
             value_print(value);
             printf("\n");
             break;
@@ -629,7 +701,15 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
         case OpCode_Jump_If_False:
         {
             uint16_t offset = READ_2BYTE(); // TODO: change name to INCREMENT_BY_2BYTES_THEN_READ()
-            if (value_is_falsey(stack_value_peek(&vm->stack_value, 0)))
+            if (value_is_falsey(STACK_PEEK(0)))
+                current_function_call->ip += offset;
+
+            break;
+        }
+        case OpCode_Jump_If_True:
+        {
+            uint16_t offset = READ_2BYTE();
+            if (!value_is_falsey(STACK_PEEK(0)))
                 current_function_call->ip += offset;
 
             break;
@@ -646,20 +726,49 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
             current_function_call->ip -= offset;
             break;
         }
+        case OpCode_Jump_If_False_Long:
+        {
+            int offset = READ_JUMP_DISTANCE_LONG();
+            if (value_is_falsey(STACK_PEEK(0)))
+                current_function_call->ip += offset;
+
+            break;
+        }
+        case OpCode_Jump_If_True_Long:
+        {
+            int offset = READ_JUMP_DISTANCE_LONG();
+            if (!value_is_falsey(STACK_PEEK(0)))
+                current_function_call->ip += offset;
+
+            break;
+        }
+        case OpCode_Jump_Long:
+        {
+            int offset = READ_JUMP_DISTANCE_LONG();
+            current_function_call->ip += offset;
+            break;
+        }
+        case OpCode_Loop_Long:
+        {
+            int offset = READ_JUMP_DISTANCE_LONG();
+            current_function_call->ip -= offset;
+            break;
+        }
         case OpCode_Return:
         {
-            Value returned_value = stack_value_pop(&vm->stack_value);
+            Value returned_value = STACK_POP();
 
-            VirtualMachine_move_value_from_stack_to_heap(vm, current_function_call->frame_start);
+            if (current_function_call->closure->function->has_captured_locals)
+                VirtualMachine_move_value_from_stack_to_heap(vm, current_function_call->frame_start);
             FunctionCall* returned_function_call = StackFunctionCall_pop(&vm->function_calls);
             if (StackFunctionCall_is_empty(&vm->function_calls)) {
-                stack_value_pop(&vm->stack_value);
+                STACK_DROP();
                 return Interpreter_Ok;
             }
 
 //          Note: Clears or Pops all the locals declared in the current function 
             vm->stack_value.top = returned_function_call->frame_start;
-            stack_value_push(&vm->stack_value, returned_value);
+            STACK_PUSH(returned_value);
             current_function_call = StackFunctionCall_peek(&vm->function_calls, 0);
 
 #ifdef DEBUG_TRACE_EXECUTION
@@ -702,6 +811,11 @@ InterpreterResult VirtualMachine_interpret(VirtualMachine* vm, ObjectFunction* s
 #undef READ_CONSTANT
 #undef READ_CONSTANT_3BYTE
 #undef READ_STRING
+#undef READ_JUMP_DISTANCE_LONG
+#undef STACK_PUSH
+#undef STACK_POP
+#undef STACK_DROP
+#undef STACK_PEEK
 }
 
 static bool Debugger_is_whitespace(char c) {
@@ -876,6 +990,7 @@ void VirtualMachine_runtime_error(VirtualMachine* vm, const char* format, ...) {
         }
     }
 
+    memset(vm->heap_values, 0, sizeof(ObjectValue*) * vm->stack_value.capacity);
     stack_value_reset(&vm->stack_value);
 }
 
@@ -890,6 +1005,10 @@ void VirtualMachine_free(VirtualMachine* vm)
 
     hash_table_free(&vm->global_database);
     hash_table_free(&vm->string_database);
+    free(vm->heap_values);
+    vm->heap_values = NULL;
+    stack_value_free(&vm->stack_value);
+    StackFunctionCall_free(&vm->function_calls);
     vm->object_init_string = NULL;
 }
 
@@ -929,6 +1048,52 @@ static void VirtualMachine_define_function_native(VirtualMachine* vm, const char
     // stack_value_pop(&vm->stack_value);
 }
 
+// Makes room for 'count' more values above 'top'. When the Stack has to move,
+// the pointers into it are rebased: 'top', the 'frame_start' of every
+// FunctionCall and the 'value_address' of the values not yet moved to the
+// heap (the Heap Values tracker grows along). Returns false past
+// 'capacity_max'.
+//
+static bool VirtualMachine_reserve_stack_value(VirtualMachine* vm, int count) {
+    StackValue* stack = &vm->stack_value;
+    int values_count  = (int)(stack->top - stack->items);
+    int values_needed = values_count + count;
+    if (values_needed <= stack->capacity)    return true;
+    if (values_needed > stack->capacity_max) return false;
+
+    int capacity = stack->capacity;
+    while (capacity < values_needed) capacity *= 2;
+    if (capacity > stack->capacity_max) capacity = stack->capacity_max;
+
+    Value* items = (Value*)malloc(sizeof(Value) * capacity);
+    if (items == NULL) return false;
+    memcpy(items, stack->items, sizeof(Value) * values_count);
+
+    ObjectValue** heap_values = (ObjectValue**)realloc(vm->heap_values, sizeof(ObjectValue*) * capacity);
+    if (heap_values == NULL) {
+        free(items);
+        return false;
+    }
+    memset(heap_values + stack->capacity, 0, sizeof(ObjectValue*) * (capacity - stack->capacity));
+    vm->heap_values = heap_values;
+
+    for (int i = 0; i < vm->function_calls.top; i++) {
+        FunctionCall* function_call = &vm->function_calls.items[i];
+        function_call->frame_start = items + (function_call->frame_start - stack->items);
+    }
+
+    for (int i = 0; i < values_count; i++) {
+        if (heap_values[i] != NULL) heap_values[i]->value_address = &items[i];
+    }
+
+    free(stack->items);
+    stack->items    = items;
+    stack->top      = items + values_count;
+    stack->capacity = capacity;
+
+    return true;
+}
+
 static bool VirtualMachine_call_closure(VirtualMachine* vm, ObjectClosure* closure, int argument_count) {
     ObjectFunction* function = closure->function;
     if (argument_count != function->arity) {
@@ -941,12 +1106,25 @@ static bool VirtualMachine_call_closure(VirtualMachine* vm, ObjectClosure* closu
         return false;
     }
 
-    StackFunctionCall_push(
+    // NOTE: The callee and its arguments are already on the Stack, they are
+    //       the first slots of the new frame.
+    //
+    int values_count = function->max_stack_depth - argument_count - 1 + STACK_VALUE_HEADROOM;
+    if (!VirtualMachine_reserve_stack_value(vm, values_count)) {
+        VirtualMachine_runtime_error(vm, "Stack Overflow.");
+        return false;
+    }
+
+    FunctionCall* function_call = StackFunctionCall_push(
         &vm->function_calls,
         closure,
         vm->stack_value.top,
         argument_count
     );
+    if (function_call == NULL) {
+        VirtualMachine_runtime_error(vm, "Function Call Stack Overflow.");
+        return false;
+    }
 
 #ifdef DEBUG_TRACE_EXECUTION
             ObjectString* function_name = function->name;
@@ -958,7 +1136,48 @@ static bool VirtualMachine_call_closure(VirtualMachine* vm, ObjectClosure* closu
     return true;
 }
 
-static bool VirtualMachine_call_method(VirtualMachine* vm, ObjectString* method_name, int argument_count) {
+// Calls 'closure' in the FunctionCall on top, the one running 'divolvi f(...)'.
+// Its captured locals are moved to the heap, then the callee and the
+// arguments slide down to 'frame_start', over the caller's locals.
+//
+static bool VirtualMachine_tail_call_closure(VirtualMachine* vm, ObjectClosure* closure, int argument_count) {
+    ObjectFunction* function = closure->function;
+    if (argument_count != function->arity) {
+        VirtualMachine_runtime_error(vm, "Expected %d arguments but got %d.", function->arity, argument_count);
+        return false;
+    }
+
+    FunctionCall* function_call = StackFunctionCall_peek(&vm->function_calls, 0);
+    Value* callee = vm->stack_value.top - argument_count - 1;
+    if (function_call->closure->function->has_captured_locals)
+        VirtualMachine_move_value_from_stack_to_heap(vm, function_call->frame_start);
+    memmove(function_call->frame_start, callee, sizeof(Value) * (argument_count + 1));
+    vm->stack_value.top = function_call->frame_start + argument_count + 1;
+
+    int values_count = function->max_stack_depth - argument_count - 1 + STACK_VALUE_HEADROOM;
+    if (!VirtualMachine_reserve_stack_value(vm, values_count)) {
+        VirtualMachine_runtime_error(vm, "Stack Overflow.");
+        return false;
+    }
+
+    function_call->closure = closure;
+    function_call->ip      = function->bytecode.instructions.items;
+
+#ifdef DEBUG_TRACE_EXECUTION
+            ObjectString* function_name = function->name;
+            char* title = function_name == NULL ? "Script" : function_name->characters;
+            printf("\n");
+            Bytecode_disassemble_header(title);
+#endif 
+
+    return true;
+}
+
+// NOTE: With 'is_tail' a Closure is called in the FunctionCall on top, see
+//       'VirtualMachine_tail_call_closure'. The receiver takes the callee's
+//       slot, so it's 'keli' in the method either way.
+//
+static bool VirtualMachine_call_method(VirtualMachine* vm, ObjectString* method_name, int argument_count, bool is_tail) {
     Value value_instance = stack_value_peek(&vm->stack_value, argument_count);
     if (!value_is_instance(value_instance)) {
         VirtualMachine_runtime_error(vm, "Only instances have methods.");
@@ -970,19 +1189,25 @@ static bool VirtualMachine_call_method(VirtualMachine* vm, ObjectString* method_
     Value value = {0};
     if (hash_table_get_value(&instance->fields, method_name, &value)) {
         vm->stack_value.top[-argument_count - 1] = value;
+        if (is_tail && value_is_closure(value))
+            return VirtualMachine_tail_call_closure(vm, value_as_closure(value), argument_count);
+
         return VirtualMachine_call_value(vm, value, argument_count);
     }
 
-    return VirtualMachine_call_from_class(vm, instance->klass, method_name, argument_count);
+    return VirtualMachine_call_from_class(vm, instance->klass, method_name, argument_count, is_tail);
 }
 
-static bool VirtualMachine_call_from_class(VirtualMachine* vm, ObjectClass* klass, ObjectString* method_name, int argument_count) {
+static bool VirtualMachine_call_from_class(VirtualMachine* vm, ObjectClass* klass, ObjectString* method_name, int argument_count, bool is_tail) {
     Value closure_method = {0};
     if (!hash_table_get_value(&klass->methods, method_name, &closure_method)) {
         VirtualMachine_runtime_error(vm, "Undefined property '%s'.", method_name->characters);
         return false;
     }
 
+    if (is_tail)
+        return VirtualMachine_tail_call_closure(vm, value_as_closure(closure_method), argument_count);
+
     return VirtualMachine_call_closure(vm, value_as_closure(closure_method), argument_count);
 }
 
@@ -1039,34 +1264,71 @@ static bool VirtualMachine_call_value(VirtualMachine* vm, Value value, int argum
     return false;
 }
 
-static ObjectValue* VirtualMachine_create_heap_value(VirtualMachine* vm, Value* value_address) {
-    ObjectValue* next = NULL;
-    LinkedList_foreach(ObjectValue, vm->heap_values, object_value) {
-        if (object_value.curr->value_address == value_address) {
-            return object_value.curr;
-        }
-        if (object_value.curr->value_address < value_address) {
-            next = object_value.next;
-            break;
-        }
+// NOTE: A function with no outsiders gets the same closure every time it's
+//       pushed, so defining or passing it around doesn't allocate. For the
+//       compiled functions it's already made, see 'Memory_end_compilation'.
+//
+static ObjectClosure* VirtualMachine_make_closure(VirtualMachine* vm, ObjectFunction* function) {
+    if (function->outsiders_count > 0) return ObjectClosure_allocate(function, &vm->objects);
+
+    if (function->closure_shared == NULL) {
+        ObjectClosure* closure = ObjectClosure_allocate(function, &vm->objects);
+        Memory_assert_reference(&function->object, &closure->object);
+        function->closure_shared = closure;
+    }
+
+    return function->closure_shared;
+}
+
+// Replaces the Instance on top of the Stack with 'method' bound to it. The
+// ObjectMethod is kept in the Instance's 'methods_bound', so reading the same
+// method again returns it instead of allocating.
+//
+// NOTE: The cached ObjectMethod is checked against 'method' because 'riba.f'
+//       and 'keli.f' share the name but not the closure.
+//
+static void VirtualMachine_bind_method(VirtualMachine* vm, ObjectString* method_name, ObjectClosure* method) {
+    ObjectInstance* instance = value_as_instance(vm->stack_value.top[-1]);
+
+    Value method_bound = {0};
+    if (
+        hash_table_get_value(&instance->methods_bound, method_name, &method_bound) &&
+        value_as_method(method_bound)->method == method
+    ) {
+        vm->stack_value.top[-1] = method_bound;
+        return;
     }
 
+    ObjectMethod* obj_method = ObjectMethod_allocate(vm->stack_value.top[-1], method, &vm->objects);
+    method_bound = value_make_object_method(obj_method);
+
+    vm->stack_value.top[-1] = method_bound; // NOTE: Keeps the Instance reachable, through the method, if the table grows
+    hash_table_set_value(&instance->methods_bound, method_name, method_bound);
+}
+
+static ObjectValue* VirtualMachine_create_heap_value(VirtualMachine* vm, Value* value_address) {
+    int slot = (int)(value_address - vm->stack_value.items);
+    if (vm->heap_values[slot] != NULL) return vm->heap_values[slot];
+
     ObjectValue* new_object_value = ObjectValue_allocate(&vm->objects, value_address);
-    if (LinkedList_is_empty(vm->heap_values)) LinkedList_push(vm->heap_values, new_object_value);
-    else if (next == NULL)                    LinkedList_push(vm->heap_values, new_object_value);
-    else                                      LinkedList_insert_after(next, new_object_value);
+    vm->heap_values[slot] = new_object_value;
 
     return new_object_value;
 }
 
+// Moves the captured values from 'value_address' up to the top of the Stack
+// to their ObjectValue, and takes them out of the tracker.
+//
 static void VirtualMachine_move_value_from_stack_to_heap(VirtualMachine* vm, Value* value_address) {
-    while (vm->heap_values != NULL && vm->heap_values->value_address >= value_address) {
-        ObjectValue* object_value = vm->heap_values;
+    int slot_start = (int)(value_address - vm->stack_value.items);
+    int slot_end   = (int)(vm->stack_value.top - vm->stack_value.items);
+    for (int slot = slot_start; slot < slot_end; slot++) {
+        ObjectValue* object_value = vm->heap_values[slot];
+        if (object_value == NULL) continue;
+
         object_value->value = *object_value->value_address;
         object_value->value_address = &object_value->value;
-
-//      Removes the current Object_Value from the Tracker from the top
-        vm->heap_values = object_value->next;
+        vm->heap_values[slot] = NULL;
     }
 }
 
@@ -1082,4 +1344,96 @@ static Value FunctionNative_clock(VirtualMachine* vm, int argument_count, Value*
         return value_make_Runtime_Error();
     }
     return value_make_number((double)clock() / CLOCKS_PER_SEC);
-}
\ No newline at end of file
+}
+
+// NOTE: The string natives below are thin wrappers around the String Kernels
+//       (see 'string_kernel.c'), they only check the arguments and convert
+//       the result to a 'Value'.
+//
+static bool FunctionNative_expect_strings(VirtualMachine* vm, const char* function_name, int count, Value* arguments) {
+    for (int i = 0; i < count; i++) {
+        if (!value_is_string(arguments[i])) {
+            VirtualMachine_runtime_error(vm, "Function '%s' expects strings as arguments.", function_name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static String FunctionNative_as_string(Value value) {
+    ObjectString* object_st = value_as_string(value);
+    return string_make(object_st->characters, object_st->length);
+}
+
+// buska(texto, palavra): index of the first 'palavra' in 'texto', or -1.
+//
+static Value FunctionNative_string_find(VirtualMachine* vm, int argument_count, Value* arguments) {
+    if (!FunctionNative_expect_strings(vm, "buska", 2, arguments)) return value_make_Runtime_Error();
+
+    String text   = FunctionNative_as_string(arguments[0]);
+    String needle = FunctionNative_as_string(arguments[1]);
+
+    return value_make_number((double)string_find(text, needle));
+}
+
+// konta(texto, palavra): how many (non-overlapping) 'palavra' are in 'texto'.
+//
+static Value FunctionNative_string_count(VirtualMachine* vm, int argument_count, Value* arguments) {
+    if (!FunctionNative_expect_strings(vm, "konta", 2, arguments)) return value_make_Runtime_Error();
+
+    String text   = FunctionNative_as_string(arguments[0]);
+    String needle = FunctionNative_as_string(arguments[1]);
+
+    return value_make_number((double)string_count(text, needle));
+}
+
+// parti(texto, separador, n): the n-th (starting at 0) piece of 'texto' split
+// on 'separador', or 'nulo' when there are less pieces than that.
+//
+// NOTE: Kriolu doesn't have lists yet, so instead of returning all the pieces
+//       at once, the script asks for them one by one.
+//
+static Value FunctionNative_string_split(VirtualMachine* vm, int argument_count, Value* arguments) {
+    if (!FunctionNative_expect_strings(vm, "parti", 2, arguments)) return value_make_Runtime_Error();
+    if (!value_is_number(arguments[2]) || value_as_number(arguments[2]) < 0) {
+        VirtualMachine_runtime_error(vm, "Function 'parti' expects a positive number as the 3(third) argument.");
+        return value_make_Runtime_Error();
+    }
+
+    String text      = FunctionNative_as_string(arguments[0]);
+    String separator = FunctionNative_as_string(arguments[1]);
+    int piece_index  = (int)value_as_number(arguments[2]);
+    if (separator.length == 0) {
+        VirtualMachine_runtime_error(vm, "Function 'parti' expects a non-empty separator.");
+        return value_make_Runtime_Error();
+    }
+
+    int start = 0;
+    for (int i = 0; i < piece_index; i++) {
+        String rest = string_make(text.characters + start, text.length - start);
+        int index   = string_find(rest, separator);
+        if (index < 0) return value_make_nil();
+
+        start += index + separator.length;
+    }
+
+    String rest = string_make(text.characters + start, text.length - start);
+    int end     = string_find(rest, separator);
+    if (end < 0) end = rest.length;
+
+    ObjectString* piece = VirtualMachine_intern_string(vm, string_make(rest.characters, end));
+    return value_make_object_string(piece);
+}
+
+// kompara(a, b): -1, 0 or 1 when 'a' is smaller, equal or bigger than 'b'.
+//
+static Value FunctionNative_string_compare(VirtualMachine* vm, int argument_count, Value* arguments) {
+    if (!FunctionNative_expect_strings(vm, "kompara", 2, arguments)) return value_make_Runtime_Error();
+
+    String a = FunctionNative_as_string(arguments[0]);
+    String b = FunctionNative_as_string(arguments[1]);
+
+    int result = string_compare(a, b);
+    return value_make_number(result < 0 ? -1 : (result > 0 ? 1 : 0));
+}
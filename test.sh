@@ -64,5 +64,41 @@ assert_parser() {
     echo "Passed $test_pass/$total tests"
 }
 
+# NOTE: Runs the script and compares what it prints. Needs a build without
+#       the compiler's trace: './build.sh --release'. The scripts too big to
+#       keep in the repository are written by 'generate_*.sh' first.
+assert_run() {
+    for file_generator_path in $(ls $TEST_DIR/run/generate_*.sh)
+    do
+        sh "$file_generator_path"
+    done
+
+    test_pass=0
+    for file_test_path in $(ls $TEST_DIR/run/*.k)
+    do 
+        file_ref_name=$(basename $file_test_path .k)
+        file_ref_contents=$(cat $TEST_DIR/run/$file_ref_name.expected)
+
+        run_output=$(./build/kriolu.exe "$file_test_path")
+        diff_output=$(diff -c -w <(echo "$run_output") <(echo "$file_ref_contents")) 
+        diff_status="$?"
+
+        if [[ "$diff_status" -eq 0 ]];
+        then
+            echo -e "\e[32mPASSED: ${file_test_path}\e[0m" 
+            test_pass=$(($test_pass + 1))
+        else
+            echo -e "\e[31mFAILED: ${file_test_path}\e[0m"
+            echo "$diff_output"
+        fi
+    done
+
+    total=$(ls $TEST_DIR/run/*.k | wc -l)
+
+    echo ""
+    echo "Passed $test_pass/$total tests"
+}
+
 assert_lexer
-assert_parser
\ No newline at end of file
+assert_parser
+assert_run
\ No newline at end of file
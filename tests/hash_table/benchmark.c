@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "kriolu.h"
+
+// Benchmark: 'HashTable' operations from 4 to 10 million keys.
+//
+// The keys are interned 'ObjectString's shaped like the identifiers of real
+// programs: a few short names ('i', 'n', 'x'), then 'snake_case' names made
+// of common words, with numeric suffixes once the words run out. Each size
+// reports, in nanoseconds per operation:
+//     insert  - inserts into an empty table, growing it from scratch
+//     hit     - lookups of keys in the table, in random order
+//     miss    - lookups of interned keys that are not in the table
+//     churn   - delete a key, insert another, keeping the count steady
+//     copy    - 'hash_table_copy' into an empty table, per key
+// and the probe lengths (Groups visited per key) after insert and after the
+// churn, from 'hash_table_get_statistics'.
+//
+// Build: ./build_benchmark_hash_table.sh
+// Usage: hash_table_benchmark [max_size]
+//
+
+//
+// Profiler
+//
+
+double get_seconds(void) {
+    struct timespec tp = { 0 };
+    int ret = timespec_get(&tp, TIME_UTC);
+    assert(ret != 0);
+    return (double)tp.tv_sec + (double)tp.tv_nsec * 1e-9;
+}
+
+// Keep the results alive so the compiler can't drop the lookups.
+volatile int g_sink;
+
+// NOTE: Small tables are rebuilt many times so that every measurement does
+//       at least this many operations.
+//
+#define OPERATIONS_MIN (1 << 22)
+
+//
+// Keys
+//
+
+const char* g_words[] = {
+    "value", "count", "index", "name", "size", "length", "result", "node",
+    "next", "list", "item", "key", "table", "buffer", "line", "token",
+    "start", "end", "first", "last", "left", "right", "parent", "child",
+    "total", "sum", "max", "min", "data", "text", "file", "path",
+    "object", "string", "number", "state", "kind", "type", "error", "offset",
+    "position", "current", "previous", "scope", "depth", "frame", "stack", "slot",
+    "klasi", "funson", "mimoria", "kantu", "pesoa", "nomi", "idadi", "lista",
+};
+#define WORDS_COUNT ((int)(sizeof(g_words) / sizeof(g_words[0])))
+
+const char* g_short_names[] = {
+    "i", "j", "k", "n", "x", "y", "z", "a", "b", "c", "id", "ok", "it", "fn", "op",
+};
+#define SHORT_NAMES_COUNT ((int)(sizeof(g_short_names) / sizeof(g_short_names[0])))
+
+// The i-th identifier of the sequence. Every index gives a different name.
+//
+String identifier_make(int index) {
+    if (index < SHORT_NAMES_COUNT)
+        return string_make_from_format("%s", g_short_names[index]);
+    index -= SHORT_NAMES_COUNT;
+
+    if (index < WORDS_COUNT)
+        return string_make_from_format("%s", g_words[index]);
+    index -= WORDS_COUNT;
+
+    int pairs_count = WORDS_COUNT * WORDS_COUNT;
+    const char* first  = g_words[(index % pairs_count) / WORDS_COUNT];
+    const char* second = g_words[index % WORDS_COUNT];
+    int suffix = index / pairs_count;
+    if (suffix == 0)
+        return string_make_from_format("%s_%s", first, second);
+
+    return string_make_from_format("%s_%s%d", first, second, suffix);
+}
+
+// Interns 'count' identifiers, in a shuffled order so that consecutive keys
+// are not consecutive in memory.
+//
+ObjectString** keys_generate(HashTable* string_database, int first, int count) {
+    ObjectString** keys = (ObjectString**)malloc(sizeof(ObjectString*) * count);
+    assert(keys);
+
+    for (int i = 0; i < count; i++) {
+        String string = identifier_make(first + i);
+        keys[i] = ObjectString_Allocate(
+            .task   = AllocateTask_Initialize | AllocateTask_Intern | AllocateTask_Check_If_Interned,
+            .string = string,
+            .hash   = string_hash(string),
+            .table  = string_database
+        );
+    }
+
+    for (int i = count - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        ObjectString* swap = keys[i];
+        keys[i] = keys[j];
+        keys[j] = swap;
+    }
+
+    return keys;
+}
+
+//
+// Benchmarks
+//
+
+int rounds_for(int size) {
+    int rounds = OPERATIONS_MIN / size;
+    return rounds < 1 ? 1 : rounds;
+}
+
+double benchmark_insert(ObjectString** keys, int size) {
+    int rounds = rounds_for(size);
+    double seconds = 0;
+    for (int r = 0; r < rounds; r++) {
+        HashTable table;
+        hash_table_init(&table);
+
+        double begin = get_seconds();
+        for (int i = 0; i < size; i++)
+            hash_table_set_value(&table, keys[i], value_make_number(i));
+        seconds += get_seconds() - begin;
+
+        hash_table_free(&table);
+    }
+
+    return seconds * 1e9 / ((double)rounds * size);
+}
+
+double benchmark_lookup(HashTable* table, ObjectString** keys, int size) {
+    int rounds = rounds_for(size);
+    int found = 0;
+    double begin = get_seconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            Value value;
+            found += hash_table_get_value(table, keys[i], &value);
+        }
+    }
+    double seconds = get_seconds() - begin;
+    g_sink = found;
+
+    return seconds * 1e9 / ((double)rounds * size);
+}
+
+// Deletes 'keys[i]' and inserts 'others[i]', then swaps the two arrays and
+// goes again, so the table keeps 'size' keys while its slots keep turning
+// over.
+//
+double benchmark_churn(HashTable* table, ObjectString** keys, ObjectString** others, int size) {
+    int rounds = rounds_for(size);
+    double begin = get_seconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            hash_table_delete(table, keys[i]);
+            hash_table_set_value(table, others[i], value_make_number(i));
+        }
+
+        ObjectString** swap = keys;
+        keys   = others;
+        others = swap;
+    }
+    double seconds = get_seconds() - begin;
+
+    // NOTE: An odd number of rounds leaves 'others' in the table, put the
+    //       original keys back so the caller's view stays valid.
+    //
+    if (rounds % 2 == 1) {
+        for (int i = 0; i < size; i++) {
+            hash_table_delete(table, keys[i]);
+            hash_table_set_value(table, others[i], value_make_number(i));
+        }
+    }
+
+    return seconds * 1e9 / ((double)rounds * size * 2);
+}
+
+double benchmark_copy(HashTable* table, int size) {
+    int rounds = rounds_for(size);
+    double seconds = 0;
+    for (int r = 0; r < rounds; r++) {
+        HashTable copy;
+        hash_table_init(&copy);
+
+        double begin = get_seconds();
+        hash_table_copy(table, &copy);
+        seconds += get_seconds() - begin;
+
+        assert(copy.count == table->count);
+        hash_table_free(&copy);
+    }
+
+    return seconds * 1e9 / ((double)rounds * size);
+}
+
+double probe_length_average(HashTableStatistics* statistics) {
+    if (statistics->count == 0) return 0;
+    return (double)statistics->probe_length_total / statistics->count;
+}
+
+//
+// Main
+//
+
+int main(int argc, char** argv) {
+    int size_max = 10000000;
+    if (argc > 1) size_max = atoi(argv[1]);
+    assert(size_max > 0);
+
+    int sizes[] = { 4, 8, 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 10000000 };
+    int sizes_count = sizeof(sizes) / sizeof(sizes[0]);
+
+    srand(69);
+    HashTable string_database;
+    hash_table_init(&string_database);
+
+    // NOTE: The miss and churn keys are a second set of identifiers, disjoint
+    //       from the first 'size_max'.
+    //
+    double begin = get_seconds();
+    ObjectString** keys   = keys_generate(&string_database, 0, size_max);
+    ObjectString** others = keys_generate(&string_database, size_max, size_max);
+    printf("Interned %d keys in %.2f seconds.\n\n", string_database.count, get_seconds() - begin);
+
+    printf(
+        "%10s | %8s %8s %8s %8s %8s | %10s %6s | %10s %6s %10s\n",
+        "size", "insert", "hit", "miss", "churn", "copy",
+        "probe avg", "max", "churn avg", "max", "tombstones"
+    );
+    for (int s = 0; s < sizes_count; s++) {
+        int size = sizes[s];
+        if (size > size_max) break;
+
+        HashTable table;
+        hash_table_init(&table);
+
+        double insert_ns = benchmark_insert(keys, size);
+        for (int i = 0; i < size; i++)
+            hash_table_set_value(&table, keys[i], value_make_number(i));
+
+        HashTableStatistics inserted = { 0 };
+        hash_table_get_statistics(&table, &inserted);
+
+        double hit_ns   = benchmark_lookup(&table, keys, size);
+        double miss_ns  = benchmark_lookup(&table, others, size);
+        double copy_ns  = benchmark_copy(&table, size);
+        double churn_ns = benchmark_churn(&table, keys, others, size);
+
+        HashTableStatistics churned = { 0 };
+        hash_table_get_statistics(&table, &churned);
+        assert(churned.count == size);
+
+        printf(
+            "%10d | %8.2f %8.2f %8.2f %8.2f %8.2f | %10.3f %6d | %10.3f %6d %10d\n",
+            size, insert_ns, hit_ns, miss_ns, churn_ns, copy_ns,
+            probe_length_average(&inserted), inserted.probe_length_max,
+            probe_length_average(&churned), churned.probe_length_max, churned.tombstones
+        );
+
+        hash_table_free(&table);
+    }
+
+    printf("\n(ns/op; probe lengths are Groups visited per key)\n");
+    return 0;
+}
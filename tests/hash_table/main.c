@@ -3,24 +3,14 @@
 #include <time.h>
 #include "kriolu.h"
 
-// NOTE: quick fix just to make this code pass the compilation error
-// TODO: refactor this code to reflect new change in the API
+// Build: ./build_test_hash_table.sh
+//
+
+// object_string.c
 //
-// object_string.h
-// 
-ObjectString* ObjectString_allocate(char* characters, int length, uint32_t hash, Object** object_head);
-ObjectString* ObjectString_allocate_if_not_interned(HashTable* table, const char* characters, int length, Object** object_head);
-ObjectString* ObjectString_allocate_and_intern(HashTable* table, char* characters, int length, uint32_t hash, Object** object_head);
-void ObjectString_init(ObjectString* object_string, char* characters, int length, uint32_t hash, Object** object_head);
 String ObjectString_to_string(ObjectString* object_string);
-ObjectString ObjectString_from_string(String string);
-ObjectString* ObjectString_is_interned(HashTable* table, String string);
 void ObjectString_free(ObjectString* string);
 
-inline bool Object_check_value_kind(Value value, ObjectKind object_kind) {
-    return (value_is_object(value) && value_as_object(value)->kind == object_kind);
-}
-
 //
 // Profiler
 //
@@ -33,10 +23,10 @@ double get_seconds(void) {
 }
 
 #define PROFILE_END(label, begin) printf("%s: %lf seconds\n", (label), get_seconds() - (begin))
-#define PROFILE_BEGIN(label) for (                                                                \
-    struct t { int i; double begin; } local = {0, get_seconds()};      \
-    local.i < 1;                                                       \
-    ++local.i, PROFILE_END(label, local.begin)                         \
+#define PROFILE_BEGIN(label) for (                                  \
+    double profile_begin = get_seconds(), profile_i = 0;               \
+    profile_i < 1;                                                     \
+    ++profile_i, PROFILE_END(label, profile_begin)                     \
 )
 
 
@@ -84,7 +74,7 @@ void _log(char* prefix, TextColor color, char* format, ...) {
 #ifdef _WIN32
 #define debugger_break() __debugbreak();
 #elif __linux__
-#define debugger_break() __builtin_debugtrap();
+#define debugger_break() __builtin_trap();
 #elif __APPLE__
 #define debugger_break() __builtin_trap();
 #endif
@@ -112,8 +102,6 @@ char* value_convert_to_text(Value value);
 
 #define N 29
 
-VirtualMachine g_vm;
-
 enum ValueType {
     Val_Boolean,
     Val_Nil,
@@ -243,7 +231,7 @@ int main(void) {
             if (is_new) count += 1;;
         }
     }
-    assert_that(key_value_table.count == N, "Expected %d new inserts, but instead got %d.\n", N, key_value_table);
+    assert_that(key_value_table.count == N, "Expected %d new inserts, but instead got %d.\n", N, key_value_table.count);
     assert_that(keys_db.count == N, "Expected %d generated keys, but got %d.", N, keys_db.count);
 
     // Generates the same key's name, length, and hash, but in a different 
@@ -277,7 +265,11 @@ int main(void) {
 void generate_keys(ObjectString** keys) {
     for (int i = 0; i < N; i++) {
         String string = string_make_from_format("key_%d", i);
-        ObjectString* key = ObjectString_allocate(string.characters, string.length, string_hash(string), NULL);
+        ObjectString* key = ObjectString_Allocate(
+            .task   = AllocateTask_Initialize,
+            .string = string,
+            .hash   = string_hash(string)
+        );
         keys[i] = key;
     }
 }
@@ -287,7 +279,12 @@ void generate_and_intern_keys(HashTable* table, ObjectString** keys, int len)
     for (int i = 0; i < len; i++)
     {
         String string = string_make_from_format("key_%d", i);
-        ObjectString* key = ObjectString_allocate_and_intern(table, string.characters, string.length, string_hash(string), NULL);
+        ObjectString* key = ObjectString_Allocate(
+            .task   = AllocateTask_Initialize | AllocateTask_Intern,
+            .string = string,
+            .hash   = string_hash(string),
+            .table  = table
+        );
         keys[i] = key;
     }
 }
@@ -306,7 +303,11 @@ void generate_random_values(Value* values, int len) {
             value = value_make_nil();
         } else if (value_type == Val_String) {
             String string = string_make_from_format("value_%d", i);
-            ObjectString* object_string = ObjectString_allocate(string.characters, string.length, string_hash(string), NULL);
+            ObjectString* object_string = ObjectString_Allocate(
+                .task   = AllocateTask_Initialize,
+                .string = string,
+                .hash   = string_hash(string)
+            );
             value = value_make_object_string(object_string);
         }
 
@@ -317,7 +318,11 @@ void generate_random_values(Value* values, int len) {
 void generate_string_values(Value* values) {
     for (int i = 0; i < N; i++) {
         String string = string_make_from_format("value_%d", i);
-        ObjectString* object_string = ObjectString_allocate(string.characters, string.length, string_hash(string), NULL);
+        ObjectString* object_string = ObjectString_Allocate(
+            .task   = AllocateTask_Initialize,
+            .string = string,
+            .hash   = string_hash(string)
+        );
         values[i] = value_make_object_string(object_string);
     }
 }
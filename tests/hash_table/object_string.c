@@ -1,83 +1,77 @@
 #include "kriolu.h"
 
-// TODO: Implement error handling logic
-//       Signature: 
-//           bool ObjectString_Allocate(.error_msg = error_msg);
-//       Usage:
-//           const char *error_msg = "";
-//           if (!ObjectString_Allocate(.error_msg = error_msg)) {
-//               printf ("Error: %s\n", error_msg);
-//               return 1;
-//           }
+// Stand-ins for the parts of the runtime that 'hash_table.c', 'string.c' and
+// 'value.c' call into, so the hash table tests and benchmark link without a
+// Virtual Machine or a Garbage Collector.
+//
+
+// Emits the external definition of the 'inline' function in 'kriolu.h'.
+extern inline bool Object_check_value_kind(Value value, ObjectKind object_kind);
+
+void* Memory_allocate(void* pointer, size_t old_size, size_t new_size) {
+    if (new_size == 0) {
+        free(pointer);
+        return NULL;
+    }
+
+    void* result = realloc(pointer, new_size);
+    assert(result);
+    return result;
+}
+
+void Memory_transaction_push(Value value) {}
+void Memory_transaction_pop() {}
+
+// Same tasks as the 'ObjectString_allocate' in 'object.c', without the
+// Garbage Collector bookkeeping.
+//
+// Usage:
 //
-// API usage:
-// 
 // ObjectString_Allocate(
 //     .task = (
-//        AllocateTask_Initialize        | 
-//        AllocateTask_Intern            | 
-//        AllocateTask_Copy_String       | 
-//        AllocateTask_Check_If_Interned 
+//        AllocateTask_Initialize        |
+//        AllocateTask_Intern            |
+//        AllocateTask_Copy_String       |
+//        AllocateTask_Check_If_Interned
 //      ),
-//     .string = string, 
+//     .string = string,
 //     .hash   = hash,
 //     .first  = first,
 //     .table  = table
 // );
-
-void ObjectString_init(ObjectString* object_string, char* characters, int length, uint32_t hash, Object** object_head) {
-    object_string->object.kind = ObjectKind_String;
-    if (object_head != NULL) LinkedList_push(*object_head, (Object*)object_string);
-
-    object_string->characters = characters;
-    object_string->length = length;
-    object_string->hash = hash;
-}
-
-ObjectString* ObjectString_allocate(char* characters, int length, uint32_t hash, Object** object_head) {
-    ObjectString* object_string = calloc(1, sizeof(ObjectString));
-    assert(object_string);
-    ObjectString_init(object_string, characters, length, hash, object_head);
-
-    return object_string;
-}
-
-ObjectString* ObjectString_is_interned(HashTable* table, String string) {
-    uint32_t hash = string_hash(string);
-    ObjectString* object_string = hash_table_get_key(table, string, hash);
-
-    return object_string;
-}
-
-ObjectString* ObjectString_allocate_and_intern(HashTable* table, char* characters, int length, uint32_t hash, Object** object_head) {
-    ObjectString* string = ObjectString_allocate(characters, length, hash, object_head);
-    assert(string);
-
-    // Interning
-    //
-    hash_table_set_value(table, string, value_make_nil());
-    return string;
-}
-
-ObjectString* ObjectString_allocate_if_not_interned(HashTable* table, const char* characters, int length, Object** object_head) {
-    assert(characters);
-
-    String source_string = string_make(characters, length);
-    uint32_t hash = string_hash(source_string);
-    ObjectString* string = hash_table_get_key(table, source_string, hash);
-    if (string == NULL) {
-        source_string = string_copy(characters, length);
-        uint32_t hash = string_hash(source_string);
-        string = ObjectString_allocate_and_intern(
-            table,
-            source_string.characters,
-            source_string.length,
-            hash,
-            object_head
-        );
+//
+ObjectString* ObjectString_allocate(AllocateParams params) {
+    ObjectString* object_string = NULL;
+
+    // .Check if it doesn't already exist
+    if (params.task & AllocateTask_Check_If_Interned)
+        object_string = hash_table_get_key(params.table, params.string, params.hash);
+
+    if (object_string == NULL) {
+        // .Allocate
+        object_string = calloc(1, sizeof(ObjectString));
+        assert(object_string);
+        object_string->object.kind = ObjectKind_String;
+        if (params.first != NULL) LinkedList_push(*params.first, (Object*)object_string);
+
+        // .Copy String
+        String string = params.string;
+        if (params.task & AllocateTask_Copy_String)
+            string = string_copy_from_other(params.string);
+
+        // .Initialize
+        if (params.task & AllocateTask_Initialize) {
+            object_string->characters = string.characters;
+            object_string->length     = string.length;
+            object_string->hash       = params.hash;
+        }
+
+        // .Intern
+        if (params.task & AllocateTask_Intern)
+            hash_table_set_value(params.table, object_string, value_make_nil());
     }
 
-    return string;
+    return object_string;
 }
 
 String ObjectString_to_string(ObjectString* object_string) {
@@ -86,24 +80,18 @@ String ObjectString_to_string(ObjectString* object_string) {
     string.length = object_string->length;
 
     return string;
-
-}
-
-ObjectString ObjectString_from_string(String string) {
-    ObjectString object_string = { 0 };
-    uint32_t hash = string_hash(string);
-
-    object_string.object.kind = ObjectKind_String;
-    object_string.characters = string.characters;
-    object_string.length = string.length;
-    object_string.hash = hash;
-
-    return object_string;
 }
 
 void ObjectString_free(ObjectString* string) {
     free(string->characters);
     free(string);
-    string->characters = NULL;
-    string->length = 0;
+}
+
+void Object_print(Object* object) {
+    if (object->kind == ObjectKind_String) {
+        ObjectString* string = (ObjectString*)object;
+        printf("%.*s", string->length, string->characters);
+    } else {
+        printf("<object>");
+    }
 }
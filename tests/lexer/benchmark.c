@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "kriolu.h"
+
+// Benchmark: 'lexer_scan' throughput, in MB/s, on large generated sources.
+//
+// The sources are made of Kriolu snippets (functions, classes, loops,
+// strings and comments) with identifiers drawn from a pool of names, some
+// of them one letter away from a keyword, so keyword classification gets
+// exercised on near misses too.
+//
+// Build: ./build_benchmark_lexer.sh
+// Usage: lexer_benchmark [megabytes]
+//
+
+//
+// Profiler
+//
+
+double get_seconds(void) {
+    struct timespec tp = { 0 };
+    int ret = timespec_get(&tp, TIME_UTC);
+    assert(ret != 0);
+    return (double)tp.tv_sec + (double)tp.tv_nsec * 1e-9;
+}
+
+//
+// Source Generator
+//
+
+const char* g_names[] = {
+    "i", "n", "x", "total", "kontador", "lista", "pesoa", "nomi", "idadi",
+    "resultadu", "valor", "index", "kabesa", "rabu", "kaza", "karu",
+    "sil", "klas", "ke", "divolv", "funsoes", "timentu", "nul", "ribas",
+};
+#define NAMES_COUNT ((int)(sizeof(g_names) / sizeof(g_names[0])))
+
+const char* g_snippets[] = {
+    "funson %s(a, b) {\n    divolvi a + b * %d;\n}\n\n",
+    "mimoria %s = %d;\n",
+    "mimoria %s = \"kaza di %d\";\n",
+    "// %s: kumentariu sobri linha %d\n",
+    "si (%s >= %d e verdadi) {\n    imprimi \"maior\";\n} sinou {\n    imprimi nulo;\n}\n",
+    "timenti (%s < %d) {\n    salta;\n}\n",
+    "pa (mimoria i = 0; i < %s; i = i + %d) {\n    si (ka falsu) sai;\n}\n",
+    "klasi %s {\n    kria(idadi) {\n        keli.idadi = idadi + %d;\n    }\n}\n\n",
+    "imprimi \"%s tem %%{idadi} anu\" + %d.5;\n",
+};
+#define SNIPPETS_COUNT ((int)(sizeof(g_snippets) / sizeof(g_snippets[0])))
+
+char* source_generate(size_t size, size_t* size_out) {
+    char* source = (char*)malloc(size + 1024);
+    assert(source);
+
+    size_t length = 0;
+    srand(69);
+    while (length < size) {
+        const char* snippet = g_snippets[rand() % SNIPPETS_COUNT];
+        const char* name = g_names[rand() % NAMES_COUNT];
+        length += sprintf(source + length, snippet, name, rand() % 1000);
+    }
+    source[length] = '\0';
+
+    *size_out = length;
+    return source;
+}
+
+//
+// Main
+//
+
+int main(int argc, char** argv) {
+    int megabytes = 64;
+    if (argc > 1) megabytes = atoi(argv[1]);
+    assert(megabytes > 0);
+
+    size_t size = 0;
+    char* source = source_generate((size_t)megabytes * 1024 * 1024, &size);
+    double megabytes_actual = (double)size / (1024.0 * 1024.0);
+
+    printf("%10s | %10s %12s %10s %12s\n", "MB", "seconds", "tokens", "MB/s", "Mtokens/s");
+
+    double seconds_best = 0;
+    long long tokens = 0;
+    for (int run = 0; run < 5; run++) {
+        Lexer lexer;
+        lexer_init(&lexer, source);
+
+        tokens = 0;
+        double begin = get_seconds();
+        for (;;) {
+            Token token = lexer_scan(&lexer);
+            if (token.kind == Token_Eof) break;
+            tokens += 1;
+        }
+        double seconds = get_seconds() - begin;
+        if (run == 0 || seconds < seconds_best) seconds_best = seconds;
+    }
+
+    printf(
+        "%10.1f | %10.3f %12lld %10.1f %12.1f\n",
+        megabytes_actual,
+        seconds_best,
+        tokens,
+        megabytes_actual / seconds_best,
+        (double)tokens / seconds_best * 1e-6
+    );
+
+    free(source);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#!/usr/bin/sh
+
+# Generates 'limits.k' and 'limits.expected': a function with more locals
+# and outsiders than a 1 byte index holds, and jumps and loops longer than
+# 64KB of bytecode.
+#
+#     sh tests/run/generate_limits.sh
+
+cd "$(dirname "$0")"
+
+count=300
+statements=10000
+terms=25000
+
+{
+    echo "// Generated by 'generate_limits.sh', don't edit."
+    echo ""
+
+    echo "// More than 256 locals."
+    echo "funson lokal() {"
+    for i in $(seq 0 $((count - 1))); do echo "    mimoria a$i = $i;"; done
+    echo "    a$((count - 1)) = a$((count - 1)) + a0 + 1;"
+    printf "    imprimi a0"
+    for i in $(seq 1 $((count - 1))); do printf " + a$i"; done
+    echo ";"
+    echo "    imprimi a$((count - 1));"
+    echo "}"
+    echo "lokal();"
+    echo ""
+
+    echo "// More than 256 outsiders, read and written, and an outsider of an outsider."
+    echo "funson fora() {"
+    for i in $(seq 0 $((count - 1))); do echo "    mimoria b$i = $i;"; done
+    echo "    funson dentru() {"
+    printf "        imprimi b0"
+    for i in $(seq 1 $((count - 1))); do printf " + b$i"; done
+    echo ";"
+    echo "        b$((count - 1)) = b$((count - 1)) + 1;"
+    echo "        funson fundu() { divolvi b$((count - 1)); }"
+    echo "        divolvi fundu;"
+    echo "    }"
+    echo "    divolvi dentru;"
+    echo "}"
+    echo "mimoria dentru = fora();"
+    echo "imprimi dentru()();"
+    echo "imprimi dentru()();"
+    echo ""
+
+    echo "// 'si' and 'sinou' over more than 64KB."
+    echo "funson si_longu(kondison) {"
+    echo "    mimoria x = 0;"
+    echo "    si (kondison) {"
+    for i in $(seq 1 $statements); do echo "        x = x + 1;"; done
+    echo "    } sinou {"
+    for i in $(seq 1 $statements); do echo "        x = x - 1;"; done
+    echo "    }"
+    echo "    divolvi x;"
+    echo "}"
+    echo "imprimi si_longu(verdadi);"
+    echo "imprimi si_longu(falsu);"
+    echo ""
+
+    echo "// 'timenti' over more than 64KB."
+    echo "funson timenti_longu() {"
+    echo "    mimoria i = 0;"
+    echo "    mimoria x = 0;"
+    echo "    timenti (i < 3) {"
+    echo "        i = i + 1;"
+    for i in $(seq 1 $statements); do echo "        x = x + 1;"; done
+    echo "    }"
+    echo "    divolvi x;"
+    echo "}"
+    echo "imprimi timenti_longu();"
+    echo ""
+
+    echo "// 'e' and 'ou' over more than 64KB."
+    echo "funson e_ou_longu(kondison) {"
+    echo "    mimoria x = 1;"
+    printf "    mimoria e_longu = kondison e (x"
+    for i in $(seq 2 $terms); do printf " + x"; done
+    echo ");"
+    printf "    mimoria ou_longu = kondison ou (x"
+    for i in $(seq 2 $terms); do printf " + x"; done
+    echo ");"
+    echo "    imprimi e_longu;"
+    echo "    imprimi ou_longu;"
+    echo "}"
+    echo "e_ou_longu(verdadi);"
+    echo "e_ou_longu(falsu);"
+} > limits.k
+
+sum=$((count * (count - 1) / 2))
+{
+    echo $((sum + 1))
+    echo $((count - 1 + 1))
+    echo $sum
+    echo $count
+    echo $((sum + 1))
+    echo $((count + 1))
+    echo $statements
+    echo -$statements
+    echo $((statements * 3))
+    echo $terms
+    echo verdadi
+    echo falsu
+    echo $terms
+} > limits.expected
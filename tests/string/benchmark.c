@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "kriolu.h"
+
+// Microbenchmark: 'string_hash' throughput across string lengths, compared
+// against the byte-at-a-time FNV-1a it replaced.
+//
+// Build: ./build_benchmark_string.sh
+//
+
+// NOTE: 'string.c' allocates through the Garbage Collector's allocator. The
+//       benchmark doesn't run a VM, so plain 'realloc' stands in for it.
+//
+void* Memory_allocate(void* pointer, size_t old_size, size_t new_size) {
+    if (new_size == 0) {
+        free(pointer);
+        return NULL;
+    }
+
+    void* result = realloc(pointer, new_size);
+    assert(result);
+    return result;
+}
+
+//
+// Profiler
+//
+
+double get_seconds(void) {
+    struct timespec tp = { 0 };
+    int ret = timespec_get(&tp, TIME_UTC);
+    assert(ret != 0);
+    return (double)tp.tv_sec + (double)tp.tv_nsec * 1e-9;
+}
+
+//
+// Reference
+//
+
+uint32_t string_hash_fnv1a(String string) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < string.length; i++)
+    {
+        hash ^= (uint8_t)string.characters[i]; // XOR
+        hash *= 16777619;
+    }
+
+    return hash;
+}
+
+typedef uint32_t (*HashFunction)(String string);
+
+// Keep the results alive so the compiler can't drop the hash calls.
+volatile uint32_t g_sink;
+
+double benchmark_hash(HashFunction hash_function, char* buffer, int length, int iterations) {
+    uint32_t sink = 0;
+    double begin = get_seconds();
+    for (int i = 0; i < iterations; i++) {
+        // Hash a different window each time, so the length of the input
+        // stays the same but the branch predictor can't learn the data.
+        String string = string_make(buffer + (i & 7), length);
+        sink ^= hash_function(string);
+    }
+    double seconds = get_seconds() - begin;
+    g_sink = sink;
+
+    return seconds;
+}
+
+//
+// Main
+//
+
+int main(void) {
+    int lengths[] = { 4, 8, 12, 16, 24, 32, 64, 128, 256, 1024, 4096, 65536, 1048576 };
+    int lengths_count = sizeof(lengths) / sizeof(lengths[0]);
+    int length_max = lengths[lengths_count - 1];
+
+    char* buffer = (char*)malloc(length_max + 8);
+    assert(buffer);
+    srand(69);
+    for (int i = 0; i < length_max + 8; i++)
+        buffer[i] = 'a' + (rand() % 26);
+
+    printf("%10s | %12s %12s | %12s %12s | %7s\n", "length", "fnv1a ns", "fnv1a MB/s", "hash ns", "hash MB/s", "speedup");
+    for (int i = 0; i < lengths_count; i++) {
+        int length = lengths[i];
+
+        // ~256MB of input per measurement, at least 1000 calls.
+        int iterations = (int)((256.0 * 1024 * 1024) / length);
+        if (iterations < 1000) iterations = 1000;
+
+        double seconds_fnv1a = benchmark_hash(string_hash_fnv1a, buffer, length, iterations);
+        double seconds_hash  = benchmark_hash(string_hash, buffer, length, iterations);
+
+        double megabytes = ((double)length * iterations) / (1024.0 * 1024.0);
+        printf(
+            "%10d | %12.2f %12.1f | %12.2f %12.1f | %6.2fx\n",
+            length,
+            seconds_fnv1a * 1e9 / iterations,
+            megabytes / seconds_fnv1a,
+            seconds_hash * 1e9 / iterations,
+            megabytes / seconds_hash,
+            seconds_fnv1a / seconds_hash
+        );
+    }
+
+    free(buffer);
+    return 0;
+}